@@ -1,13 +1,36 @@
 #include "doctest.h"
 #include "sources/Algorithms.hpp"
+#include "sources/BellmanFord.hpp"
+#include "sources/Bidirectional.hpp"
+#include "sources/ContractionHierarchy.hpp"
+#include "sources/DifferenceConstraints.hpp"
+#include "sources/Landmarks.hpp"
 #include "sources/Graph.hpp"
+#include "sources/Generators.hpp"
+#include "sources/Johnson.hpp"
+#include "sources/Parallel.hpp"
+#include "sources/StronglyConnected.hpp"
+#include "sources/Topological.hpp"
+#include "sources/UnionFind.hpp"
 #include <vector>
 #include <sstream>
 #include <limits>
+#include <algorithm>
+#include <atomic>
+#include <thread>
 using namespace std;
 using namespace ariel;
 #define SIZE_TYPE static_cast<std::vector<int>::size_type> // Correct macro definition
 
+// Sets the worker count for a scope and restores the default when the scope ends, also when a
+// REQUIRE or an exception ends the test early
+struct WorkerScope {
+    explicit WorkerScope(size_t count) { setWorkerCount(count); }
+    ~WorkerScope() { setWorkerCount(0); }
+    WorkerScope(const WorkerScope&) = delete;
+    WorkerScope& operator=(const WorkerScope&) = delete;
+};
+
 TEST_CASE("Test graph addition")
 {
     ariel::Graph g1;
@@ -217,3 +240,1422 @@ TEST_CASE("Copy and assignment") {
     CHECK(g2.printGraph() == g1.printGraph());
     CHECK(g3.printGraph() == g1.printGraph());
 }
+
+TEST_CASE("Transpose and reversed view") {
+    Graph g;
+    vector<vector<int>> directed = {{0, 1, 0}, {0, 0, 2}, {3, 0, 0}};
+    g.loadGraph(directed);
+    Graph t = g.transpose();
+    CHECK(t.printGraph() == "[0, 0, 3]\n[1, 0, 0]\n[0, 2, 0]");
+    CHECK(t.transpose().printGraph() == g.printGraph());
+
+    TransposedView view = g.transposed();
+    CHECK(view.vertices() == 3);
+    for (size_t i = 0; i < 3; ++i) {
+        for (size_t j = 0; j < 3; ++j) {
+            CHECK(view.weight(i, j) == t.getGraph()[i][j]);
+        }
+    }
+
+    // Large enough to exercise the recursive blocking on uneven splits
+    int size = 37;
+    vector<vector<int>> big(SIZE_TYPE(size), vector<int>(SIZE_TYPE(size)));
+    for (size_t i = 0; i < SIZE_TYPE(size); ++i) {
+        for (size_t j = 0; j < SIZE_TYPE(size); ++j) {
+            big[i][j] = static_cast<int>(i * 100 + j);
+        }
+    }
+    Graph b;
+    b.loadGraph(big);
+    Graph bt = b.transpose();
+    for (size_t i = 0; i < SIZE_TYPE(size); ++i) {
+        for (size_t j = 0; j < SIZE_TYPE(size); ++j) {
+            INFO("row ", i, ", column ", j);
+            CHECK(bt.getGraph()[j][i] == big[i][j]);
+        }
+    }
+}
+
+TEST_CASE("Sparse row and column index") {
+    Graph g;
+    vector<vector<int>> directed = {{0, 1, 5}, {0, 0, 2}, {3, 0, 0}};
+    g.loadGraph(directed);
+
+    SparseIndex out = g.csr();
+    CHECK(out.vertices() == 3);
+    CHECK(out.nonZeros() == 4);
+    CHECK(out.degree(0) == 2);
+    CHECK(out.indices == vector<int>({1, 2, 2, 0}));
+    CHECK(out.weights == vector<int>({1, 5, 2, 3}));
+
+    SparseIndex in = g.csc();
+    CHECK(in.offsets == vector<size_t>({0, 1, 2, 4}));
+    CHECK(in.indices == vector<int>({2, 0, 0, 1})); // In-neighbors, sorted per column
+    CHECK(in.weights == vector<int>({3, 1, 5, 2}));
+}
+
+TEST_CASE("Kronecker product") {
+    Graph a, b;
+    vector<vector<int>> left = {{0, 2}, {1, 0}};
+    vector<vector<int>> right = {{1, 3}, {0, 1}};
+    a.loadGraph(left);
+    b.loadGraph(right);
+    Graph k = a.kronecker(b);
+    CHECK(k.vertices() == 4);
+    CHECK(k.printGraph() == "[0, 0, 2, 6]\n[0, 0, 0, 2]\n[1, 3, 0, 0]\n[0, 1, 0, 0]");
+
+    Graph empty;
+    CHECK_THROWS(a.kronecker(empty));
+    Graph big;
+    vector<vector<int>> maxWeights = {{numeric_limits<int>::max()}};
+    big.loadGraph(maxWeights);
+    CHECK_THROWS_AS(big.kronecker(a), std::overflow_error);
+}
+
+TEST_CASE("Parallel loops run on a reused worker pool") {
+    WorkerScope four(4);
+    vector<std::thread::id> first(4), second(4);
+    std::atomic<size_t> covered{0};
+    parallelFor(400, 1, [&](size_t begin, size_t end, size_t worker) {
+        first[worker] = std::this_thread::get_id();
+        // A nested loop runs inline on the worker that issues it
+        parallelFor(end - begin, 1, [&](size_t innerBegin, size_t innerEnd, size_t) {
+            covered.fetch_add(innerEnd - innerBegin, std::memory_order_relaxed);
+        });
+    });
+    parallelFor(4, 1, [&](size_t, size_t, size_t worker) { second[worker] = std::this_thread::get_id(); });
+    CHECK(covered.load() == 400);
+    CHECK(first[0] == std::this_thread::get_id());
+    for (size_t worker = 1; worker < 4; ++worker) {
+        INFO("worker ", worker);
+        CHECK(first[worker] != std::this_thread::get_id());
+        CHECK(second[worker] == first[worker]);
+    }
+}
+
+TEST_CASE("Generators are seeded and reproducible across worker counts") {
+    EdgeStream rmat = Generators::rmat(8, 8, 42);
+    CHECK(rmat.numVertices == 256);
+    CHECK(rmat.numEdges == 2048);
+
+    SparseIndex serial, parallel;
+    {
+        WorkerScope one(1);
+        serial = Generators::toSparse(rmat);
+    }
+    {
+        WorkerScope four(4);
+        parallel = Generators::toSparse(rmat);
+    }
+    CHECK(serial.offsets == parallel.offsets);
+    CHECK(serial.indices == parallel.indices);
+    CHECK(serial.weights == parallel.weights);
+
+    // Streaming into CSR matches going through the dense matrix
+    SparseIndex viaDense = Generators::toGraph(rmat).csr();
+    CHECK(serial.indices == viaDense.indices);
+    CHECK(serial.offsets == viaDense.offsets);
+
+    EdgeStream er = Generators::erdosRenyi(50, 200, 7, 9);
+    SparseIndex erIndex = Generators::toSparse(er);
+    SparseIndex erAgain = Generators::toSparse(Generators::erdosRenyi(50, 200, 7, 9));
+    CHECK(erIndex.weights == erAgain.weights);
+    CHECK(erIndex.nonZeros() <= 200);
+    CHECK(Generators::toSparse(Generators::erdosRenyi(50, 200, 8, 9)).indices != erIndex.indices);
+
+    EdgeStream pl = Generators::powerLaw(100, 400, 2.5, 3);
+    SparseIndex plIndex = Generators::toSparse(pl);
+    CHECK(plIndex.vertices() == 100);
+    CHECK(plIndex.degree(0) > plIndex.degree(99)); // Low ids carry most of the weight
+
+    CHECK_THROWS(Generators::rmat(0, 8, 1));
+    CHECK_THROWS(Generators::powerLaw(10, 10, 1.0, 1));
+}
+
+TEST_CASE("Grid generator") {
+    Graph grid = Generators::toGraph(Generators::grid2D(3, 4));
+    CHECK(grid.vertices() == 12);
+    CHECK(grid.countEdges() == 17); // 3 * 3 horizontal + 2 * 4 vertical, counted once each
+    CHECK(grid.transpose().printGraph() == grid.printGraph());
+    SparseIndex index = grid.csr();
+    CHECK(index.degree(0) == 2);  // Corner
+    CHECK(index.degree(5) == 4);  // Interior
+}
+
+TEST_CASE("Matrix-vector products") {
+    Graph g;
+    vector<vector<int>> directed = {{0, 1, 2}, {3, 0, 0}, {0, 4, 5}};
+    g.loadGraph(directed);
+    vector<double> x = {1, 2, 3};
+    CHECK(g.mxv(x) == vector<double>({8, 3, 23}));
+    CHECK(g.vxm(x) == vector<double>({6, 13, 17}));
+    CHECK(g.csr().mxv(x) == g.mxv(x));
+    CHECK(g.csc().mxv(x) == g.vxm(x)); // CSC multiplies by the transpose
+
+    SparseVector sx;
+    sx.indices = {2, 0};
+    sx.values = {3, 1};
+    CHECK(g.mxv(sx) == vector<double>({6, 3, 15}));
+    CHECK(g.vxm(sx) == vector<double>({0, 13, 17}));
+
+    CHECK_THROWS_AS(g.mxv(vector<double>({1, 2})), std::invalid_argument);
+    sx.indices = {3, 0};
+    CHECK_THROWS_AS(g.vxm(sx), std::out_of_range);
+    sx.indices = {0, 1, 2}; // One index more than there are values
+    CHECK_THROWS_AS(g.mxv(sx), std::invalid_argument);
+    CHECK_THROWS_AS(g.vxm(sx), std::invalid_argument);
+}
+
+TEST_CASE("Merge-path SpMV matches the dense product on skewed graphs") {
+    Graph g = Generators::toGraph(Generators::rmat(11, 32, 5));
+    SparseIndex index = g.csr();
+    vector<double> x(g.vertices());
+    for (size_t i = 0; i < x.size(); ++i) {
+        x[i] = static_cast<double>(i % 7); // Integer values keep every sum exact
+    }
+    vector<double> dense = g.mxv(x);
+    WorkerScope three(3);
+    CHECK(index.mxv(x) == dense);
+}
+
+TEST_CASE("Connectivity and unweighted shortest path") {
+    Graph g;
+    vector<vector<int>> graph = {
+            {0, 1, 0, 0, 1},
+            {1, 0, 1, 0, 0},
+            {0, 1, 0, 1, 0},
+            {0, 0, 1, 0, 1},
+            {1, 0, 0, 1, 0}};
+    g.loadGraph(graph);
+    CHECK(Algorithms::isConnected(g));
+    CHECK(Algorithms::shortestPath(g, 0, 3) == "0->4->3");
+    CHECK(Algorithms::shortestPath(g, 2, 2) == "2");
+    CHECK_THROWS_AS(Algorithms::shortestPath(g, 0, 5), std::out_of_range);
+
+    Graph split;
+    vector<vector<int>> twoParts = {{0, 1, 0}, {1, 0, 0}, {0, 0, 0}};
+    split.loadGraph(twoParts);
+    CHECK_FALSE(Algorithms::isConnected(split));
+    CHECK(Algorithms::shortestPath(split, 0, 2) == "-1");
+
+    Graph directed; // 0 -> 1 -> 2, nothing leads back
+    vector<vector<int>> chain = {{0, 1, 0}, {0, 0, 1}, {0, 0, 0}};
+    directed.loadGraph(chain);
+    CHECK(Algorithms::isConnected(directed));
+    CHECK(Algorithms::shortestPath(directed, 2, 0) == "-1");
+}
+
+TEST_CASE("Direction-optimizing BFS agrees on dense and sparse storage") {
+    Graph g = Generators::toGraph(Generators::rmat(8, 8, 11));
+    SparseIndex out = g.csr();
+    SparseIndex in = g.csc();
+    BFSTree dense = Algorithms::bfs(g, 0);
+    BFSTree sparse = Algorithms::bfs(out, in, 0);
+    CHECK(dense.depth == sparse.depth);
+
+    // Reference levels from a plain queue BFS over the matrix
+    vector<int> expected(g.vertices(), -1);
+    vector<size_t> queue = {0};
+    expected[0] = 0;
+    for (size_t i = 0; i < queue.size(); ++i) {
+        for (size_t v = 0; v < g.vertices(); ++v) {
+            if (g.getGraph()[queue[i]][v] != 0 && expected[v] == -1) {
+                expected[v] = expected[queue[i]] + 1;
+                queue.push_back(v);
+            }
+        }
+    }
+    CHECK(dense.depth == expected);
+    for (size_t v = 1; v < g.vertices(); ++v) {
+        if (dense.depth[v] > 0) {
+            INFO("vertex ", v);
+            size_t p = static_cast<size_t>(dense.parent[v]);
+            CHECK(g.getGraph()[p][v] != 0);
+            CHECK(dense.depth[p] + 1 == dense.depth[v]);
+        }
+    }
+
+    // A long grid path forces several switches between the two directions
+    Graph grid = Generators::toGraph(Generators::grid2D(4, 30));
+    BFSTree gridTree = Algorithms::bfs(grid, 0);
+    CHECK(gridTree.depth[119] == 3 + 29);
+    CHECK(Algorithms::isConnected(grid));
+    CHECK_THROWS(Algorithms::bfs(out, g.csr(), -1));
+}
+
+TEST_CASE("Bipartite partition") {
+    Graph g;
+    vector<vector<int>> evenCycle = {
+            {0, 1, 0, 1},
+            {1, 0, 1, 0},
+            {0, 1, 0, 1},
+            {1, 0, 1, 0}};
+    g.loadGraph(evenCycle);
+    CHECK(Algorithms::isBipartite(g) == "The graph is bipartite: A={0, 2}, B={1, 3}");
+
+    vector<vector<int>> triangle = {{0, 1, 1}, {1, 0, 1}, {1, 1, 0}};
+    g.loadGraph(triangle);
+    CHECK(Algorithms::isBipartite(g) == "0");
+
+    vector<vector<int>> twoEdges = {{0, 1, 0, 0}, {1, 0, 0, 0}, {0, 0, 0, 1}, {0, 0, 1, 0}};
+    g.loadGraph(twoEdges);
+    CHECK(Algorithms::isBipartite(g) == "The graph is bipartite: A={0, 2}, B={1, 3}");
+}
+
+TEST_CASE("Parallel BFS levels match the sequential engine") {
+    Graph g = Generators::toGraph(Generators::rmat(11, 32, 17));
+    SparseIndex out = g.csr();
+    SparseIndex in = g.csc();
+
+    BFSTree serialDense, serialSparse, parallelDense, parallelSparse;
+    bool serialConnected = false, parallelConnected = false;
+    string path;
+    {
+        WorkerScope one(1);
+        serialDense = Algorithms::bfs(g, 0);
+        serialSparse = Algorithms::bfs(out, in, 0);
+        serialConnected = Algorithms::isConnected(g);
+    }
+    {
+        WorkerScope four(4);
+        parallelDense = Algorithms::bfs(g, 0);
+        parallelSparse = Algorithms::bfs(out, in, 0);
+        parallelConnected = Algorithms::isConnected(g);
+        path = Algorithms::shortestPath(g, 0, static_cast<int>(g.vertices() - 1));
+    }
+
+    CHECK(parallelDense.depth == serialDense.depth);
+    CHECK(parallelSparse.depth == serialSparse.depth);
+    CHECK(serialDense.depth == serialSparse.depth);
+    CHECK(parallelConnected == serialConnected);
+    for (size_t v = 0; v < g.vertices(); ++v) {
+        if (parallelDense.depth[v] > 0) {
+            INFO("vertex ", v);
+            size_t p = static_cast<size_t>(parallelDense.parent[v]);
+            CHECK(g.getGraph()[p][v] != 0);
+            CHECK(parallelDense.depth[p] + 1 == parallelDense.depth[v]);
+        }
+    }
+    int hops = serialDense.depth[g.vertices() - 1];
+    CHECK((hops == -1 ? path == "-1" : static_cast<int>(std::count(path.begin(), path.end(), '>')) == hops));
+}
+
+TEST_CASE("Connected component labeling") {
+    Graph g;
+    vector<vector<int>> graph = {
+            {0, 1, 0, 0, 0, 0},
+            {1, 0, 0, 0, 0, 0},
+            {0, 0, 0, 1, 1, 0},
+            {0, 0, 1, 0, 0, 0},
+            {0, 0, 1, 0, 0, 0},
+            {0, 0, 0, 0, 0, 0}};
+    g.loadGraph(graph);
+    Components components = Algorithms::connectedComponents(g);
+    CHECK(components.count() == 3);
+    CHECK(components.label == vector<int>({0, 0, 1, 1, 1, 2}));
+    CHECK(components.sizes == vector<size_t>({2, 3, 1}));
+    CHECK_FALSE(Algorithms::isConnected(g));
+
+    // Directed edges join weak components in either direction
+    vector<vector<int>> directed = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}};
+    g.loadGraph(directed);
+    CHECK(Algorithms::connectedComponents(g).count() == 1);
+    CHECK_FALSE(Algorithms::isConnected(g)); // Nothing is reachable from vertex 0
+
+    Graph empty;
+    CHECK(Algorithms::connectedComponents(empty).count() == 0);
+}
+
+TEST_CASE("Afforest components match BFS reachability") {
+    // Sparse random graph: many small components next to a large one
+    EdgeStream er = Generators::erdosRenyi(600, 420, 21);
+    vector<vector<int>> oneWay(600, vector<int>(600, 0));
+    vector<vector<int>> bothWays(600, vector<int>(600, 0));
+    for (size_t k = 0; k < er.numEdges; ++k) {
+        auto [u, v, w] = er.edge(k);
+        oneWay[SIZE_TYPE(u)][SIZE_TYPE(v)] = w;
+        bothWays[SIZE_TYPE(u)][SIZE_TYPE(v)] = w;
+        bothWays[SIZE_TYPE(v)][SIZE_TYPE(u)] = w;
+    }
+    Graph directed, undirected;
+    directed.loadGraph(oneWay);
+    undirected.loadGraph(bothWays);
+
+    // Reference labeling: one BFS per unlabeled vertex, numbered in vertex order
+    vector<int> expected(600, -1);
+    int next = 0;
+    for (size_t v = 0; v < 600; ++v) {
+        if (expected[v] == -1) {
+            BFSTree tree = Algorithms::bfs(undirected, static_cast<int>(v));
+            for (size_t u = 0; u < 600; ++u) {
+                if (tree.depth[u] != -1) {
+                    expected[u] = next;
+                }
+            }
+            ++next;
+        }
+    }
+
+    Components parallel, weak, serial;
+    {
+        WorkerScope four(4);
+        parallel = Algorithms::connectedComponents(undirected);
+        weak = Algorithms::connectedComponents(directed);
+    }
+    {
+        WorkerScope one(1);
+        serial = Algorithms::connectedComponents(undirected);
+    }
+    CHECK(parallel.label == expected);
+    CHECK(serial.label == expected);
+    CHECK(weak.label == expected);
+    CHECK(parallel.count() == static_cast<size_t>(next));
+    CHECK(Algorithms::isConnected(undirected) == (next == 1));
+}
+
+TEST_CASE("Cycle detection returns the cycle") {
+    Graph g;
+    vector<vector<int>> triangleWithTail = {
+            {0, 1, 0, 0},
+            {1, 0, 1, 1},
+            {0, 1, 0, 1},
+            {0, 1, 1, 0}};
+    g.loadGraph(triangleWithTail);
+    CHECK(Algorithms::isContainsCycle(g));
+    auto cycle = Algorithms::findCycle(g);
+    REQUIRE(cycle.has_value());
+    vector<int> members = *cycle;
+    std::sort(members.begin(), members.end());
+    CHECK(members == vector<int>({1, 2, 3}));
+
+    vector<vector<int>> tree = {{0, 1, 1, 0}, {1, 0, 0, 1}, {1, 0, 0, 0}, {0, 1, 0, 0}};
+    g.loadGraph(tree);
+    CHECK_FALSE(Algorithms::isContainsCycle(g));
+    CHECK_FALSE(Algorithms::findCycle(g).has_value());
+
+    // A long path closed into a ring: deep enough that recursion would be costly
+    size_t size = 1500;
+    vector<vector<int>> ring(size, vector<int>(size, 0));
+    for (size_t i = 0; i < size; ++i) {
+        ring[i][(i + 1) % size] = 1;
+        ring[(i + 1) % size][i] = 1;
+    }
+    g.loadGraph(ring);
+    auto longCycle = Algorithms::findCycle(g);
+    REQUIRE(longCycle.has_value());
+    CHECK(longCycle->size() == size);
+}
+
+TEST_CASE("Graph direction is detected or declared once") {
+    Graph g;
+    vector<vector<int>> symmetric = {{0, 2}, {2, 0}};
+    vector<vector<int>> oneWay = {{0, 2}, {0, 0}};
+    g.loadGraph(symmetric);
+    CHECK_FALSE(g.isDirected());
+    g.loadGraph(oneWay);
+    CHECK(g.isDirected());
+    g.loadGraph(symmetric, true);
+    CHECK(g.isDirected());
+    CHECK_THROWS_AS(g.loadGraph(oneWay, false), std::invalid_argument);
+
+    Graph a, b;
+    a.loadGraph(oneWay);
+    b.loadGraph(vector<vector<int>>({{0, 0}, {2, 0}}));
+    a += b; // The two one-way edges add up to a symmetric matrix
+    CHECK_FALSE(a.isDirected());
+    CHECK((-b).isDirected());
+
+    // A declared direction survives the operators even though the matrix stays symmetric
+    Graph declared, zero;
+    declared.loadGraph(symmetric, true);
+    zero.loadGraph(vector<vector<int>>({{0, 0}, {0, 0}}));
+    declared += zero;
+    CHECK(declared.isDirected());
+    CHECK(Algorithms::findCycle(declared) == vector<int>({0, 1}));
+    CHECK((declared - zero).isDirected());
+    declared -= zero;
+    declared *= declared;
+    CHECK(declared.isDirected());
+    CHECK((declared * 2).isDirected());
+    CHECK(declared.transpose().isDirected());
+}
+
+TEST_CASE("Directed and undirected cycle engines") {
+    Graph g;
+    // Undirected: a single edge is not a cycle, a triangle is
+    vector<vector<int>> edge = {{0, 1}, {1, 0}};
+    g.loadGraph(edge);
+    CHECK_FALSE(Algorithms::isContainsCycle(g));
+    // Declared directed, the same matrix is the 2-cycle 0->1->0
+    g.loadGraph(edge, true);
+    auto twoCycle = Algorithms::findCycle(g);
+    REQUIRE(twoCycle.has_value());
+    CHECK(*twoCycle == vector<int>({0, 1}));
+
+    vector<vector<int>> square = {{0, 1, 0, 1}, {1, 0, 1, 0}, {0, 1, 0, 1}, {1, 0, 1, 0}};
+    g.loadGraph(square);
+    auto undirectedCycle = Algorithms::findUndirectedCycle(g);
+    REQUIRE(undirectedCycle.has_value());
+    CHECK(undirectedCycle->size() == 4);
+
+    // Directed acyclic: the undirected shadow has a cycle, the directed graph does not
+    vector<vector<int>> dag = {{0, 1, 1}, {0, 0, 1}, {0, 0, 0}};
+    g.loadGraph(dag);
+    CHECK(g.isDirected());
+    CHECK_FALSE(Algorithms::isContainsCycle(g));
+    CHECK(Algorithms::findUndirectedCycle(g).has_value());
+    // The same triangle stored below the diagonal
+    g.loadGraph({{0, 0, 0}, {1, 0, 0}, {1, 1, 0}});
+    CHECK_FALSE(Algorithms::isContainsCycle(g));
+    auto lower = Algorithms::findUndirectedCycle(g);
+    REQUIRE(lower.has_value());
+    CHECK(lower->size() == 3);
+
+    vector<vector<int>> directedRing = {{0, 1, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 1}, {0, 1, 0, 0}};
+    g.loadGraph(directedRing);
+    auto ring = Algorithms::findDirectedCycle(g);
+    REQUIRE(ring.has_value());
+    CHECK(*ring == vector<int>({1, 2, 3}));
+
+    vector<vector<int>> selfLoop = {{0, 0}, {0, 3}};
+    g.loadGraph(selfLoop);
+    CHECK(Algorithms::findCycle(g) == std::optional<vector<int>>(vector<int>({1})));
+}
+
+TEST_CASE("Typed path and bipartition results") {
+    Graph g;
+    vector<vector<int>> weighted = {
+            {0, 4, 0, 0},
+            {4, 0, 2, 0},
+            {0, 2, 0, 7},
+            {0, 0, 7, 0}};
+    g.loadGraph(weighted);
+
+    Path path;
+    CHECK(Algorithms::shortestPath(g, 0, 3, path));
+    CHECK(path.found());
+    CHECK(path.vertices == vector<int>({0, 1, 2, 3}));
+    CHECK(path.span().size() == 4);
+    CHECK(path.cost == 13);
+    CHECK(path.toString() == "0->1->2->3");
+
+    // The buffer is reused and cleared for a failed query
+    const int* buffer = path.vertices.data();
+    CHECK(Algorithms::shortestPath(g, 3, 1, path));
+    CHECK(path.vertices.data() == buffer);
+    vector<vector<int>> apart = {{0, 1, 0}, {1, 0, 0}, {0, 0, 0}};
+    Graph split;
+    split.loadGraph(apart);
+    CHECK_FALSE(Algorithms::shortestPath(split, 0, 2, path));
+    CHECK_FALSE(path.found());
+    CHECK(path.toString() == "-1");
+
+    Bipartition parts;
+    CHECK(Algorithms::bipartition(g, parts));
+    CHECK(parts.color == vector<int>({0, 1, 0, 1}));
+    CHECK(parts.toString() == Algorithms::isBipartite(g));
+    vector<vector<int>> triangle = {{0, 1, 1}, {1, 0, 1}, {1, 1, 0}};
+    g.loadGraph(triangle);
+    CHECK_FALSE(Algorithms::bipartition(g, parts));
+    CHECK(parts.toString() == "0");
+}
+
+TEST_CASE("Weighted shortest path") {
+    Graph g;
+    // The direct edge 0-3 is heavier than the detour through 1 and 2
+    vector<vector<int>> weighted = {
+            {0, 1, 0, 10},
+            {1, 0, 2, 0},
+            {0, 2, 0, 3},
+            {10, 0, 3, 0}};
+    g.loadGraph(weighted);
+    CHECK(Algorithms::shortestPath(g, 0, 3) == "0->1->2->3");
+    Path path;
+    CHECK(Algorithms::dijkstra(g, 0, 3, path));
+    CHECK(path.cost == 6);
+    CHECK(Algorithms::dijkstra(g, 3, 0, path, false));
+    CHECK(path.toString() == "3->2->1->0");
+    CHECK(path.cost == 6);
+
+    // Directed graph with a negative edge goes through Bellman-Ford
+    vector<vector<int>> negative = {{0, 4, 1}, {0, 0, 0}, {0, -2, 0}};
+    g.loadGraph(negative);
+    CHECK(Algorithms::shortestPath(g, 0, 1, path));
+    CHECK(path.vertices == vector<int>({0, 2, 1}));
+    CHECK(path.cost == -1);
+    CHECK_THROWS_AS(Algorithms::dijkstra(g, 0, 1, path), std::invalid_argument);
+
+    // An undirected negative edge is a negative cycle: no lightest path exists
+    vector<vector<int>> negativeUndirected = {{0, -1}, {-1, 0}};
+    g.loadGraph(negativeUndirected);
+    CHECK(Algorithms::shortestPath(g, 0, 1) == "-1");
+}
+
+TEST_CASE("Radix and d-ary heaps agree on random weights") {
+    Graph g = Generators::toGraph(Generators::erdosRenyi(300, 3000, 9, 1000));
+    Path radix, dary;
+    for (int dest = 1; dest < 300; dest += 13) {
+        INFO("dest ", dest);
+        bool foundRadix = Algorithms::dijkstra(g, 0, dest, radix, true);
+        bool foundDary = Algorithms::dijkstra(g, 0, dest, dary, false);
+        CHECK(foundRadix == foundDary);
+        CHECK(radix.cost == dary.cost);
+        long long walked = 0;
+        for (size_t i = 1; i < radix.vertices.size(); ++i) {
+            walked += g.getGraph()[SIZE_TYPE(radix.vertices[i - 1])][SIZE_TYPE(radix.vertices[i])];
+        }
+        CHECK(walked == radix.cost);
+    }
+}
+
+TEST_CASE("Delta-stepping matches Dijkstra") {
+    SparseIndex csr = Generators::toSparse(Generators::rmat(10, 8, 4, 0.57, 0.19, 0.19, 500));
+    Graph g = Generators::toGraph(Generators::rmat(10, 8, 4, 0.57, 0.19, 0.19, 500));
+    Path path;
+    std::vector<long long> expected;
+    for (int dest = 0; dest < 1024; dest += 7) {
+        expected.push_back(Algorithms::dijkstra(g, 0, dest, path) ? path.cost : LLONG_MAX);
+    }
+    for (size_t workers : {size_t(1), size_t(4)}) {
+        WorkerScope scope(workers);
+        for (long long delta : {0LL, 1LL, 50LL, 100000LL}) {
+            std::vector<long long> distance = Algorithms::deltaStepping(csr, 0, delta);
+            for (int dest = 0; dest < 1024; dest += 7) {
+                INFO("workers ", workers, ", delta ", delta, ", dest ", dest);
+                CHECK(distance[SIZE_TYPE(dest)] == expected[SIZE_TYPE(dest / 7)]);
+            }
+        }
+    }
+    CHECK(Algorithms::deltaStepping(g, 0) == Algorithms::deltaStepping(csr, 0));
+
+    // A tiny delta against huge weights: the ring stays bounded and empty buckets are skipped
+    Graph heavy;
+    heavy.loadGraph({{0, 1000000000, 0}, {0, 0, 1}, {0, 0, 0}});
+    CHECK(Algorithms::deltaStepping(heavy.csr(), 0, 1) == std::vector<long long>{0, 1000000000, 1000000001});
+    std::vector<std::vector<int>> chain(60, std::vector<int>(60, 0));
+    for (size_t v = 0; v + 1 < 60; ++v) {
+        chain[v][v + 1] = v % 2 == 0 ? INT_MAX : 1;
+    }
+    Graph longChain;
+    longChain.loadGraph(chain);
+    std::vector<long long> chainDistance = Algorithms::deltaStepping(longChain, 0, 1);
+    CHECK(chainDistance[59] == 30LL * INT_MAX + 29);
+    CHECK(chainDistance == Algorithms::bellmanFord(longChain, 0).distance);
+
+    Graph negative;
+    negative.loadGraph({{0, -1}, {2, 0}});
+    CHECK_THROWS_AS(Algorithms::deltaStepping(negative, 0), std::invalid_argument);
+}
+
+TEST_CASE("Bidirectional search") {
+    // Grid: every lightest path has the Manhattan length
+    SparseIndex out = Generators::toSparse(Generators::grid2D(60, 60));
+    SparseIndex in = out;
+    SparseAdjacency grid(out, in);
+    BidirectionalSearch search;
+    BFSEngine single;
+    Path path;
+    CHECK(search.bfs(grid, 60 * 30 + 5, 60 * 30 + 55, path));
+    CHECK(path.cost == 50);
+    CHECK(path.vertices.size() == 51);
+    CHECK(search.explored < single.run(grid, 60 * 30 + 5, 60 * 30 + 55));
+
+    // Sparse random graph: the frontiers fan out, so meeting in the middle saves far more
+    Graph sparse = Generators::toGraph(Generators::erdosRenyi(800, 3200, 2));
+    DenseAdjacency dense(sparse);
+    BFSTree tree = Algorithms::bfs(sparse, 0);
+    for (size_t dest = 1; dest < 800; dest += 79) {
+        INFO("dest ", dest);
+        bool found = search.bfs(dense, 0, dest, path);
+        CHECK(found == (tree.depth[dest] != -1));
+        if (found) {
+            CHECK(path.cost == tree.depth[dest]);
+            CHECK(4 * search.explored < single.run(dense, 0, dest));
+        }
+    }
+
+    // Weighted: agrees with one-sided Dijkstra, including unreachable pairs
+    Graph g = Generators::toGraph(Generators::erdosRenyi(200, 500, 12, 100));
+    Path expected;
+    for (int dest = 0; dest < 200; dest += 3) {
+        INFO("dest ", dest);
+        bool found = Algorithms::dijkstra(g, 5, dest, expected);
+        CHECK(Algorithms::shortestPath(g, 5, dest, path) == found);
+        CHECK(path.cost == expected.cost);
+        long long walked = 0;
+        for (size_t i = 1; i < path.vertices.size(); ++i) {
+            walked += g.getGraph()[SIZE_TYPE(path.vertices[i - 1])][SIZE_TYPE(path.vertices[i])];
+        }
+        CHECK(walked == path.cost);
+        CHECK((path.vertices.empty() || path.vertices.front() == 5));
+    }
+}
+
+TEST_CASE("Landmark A* queries") {
+    Graph g = Generators::toGraph(Generators::erdosRenyi(300, 1500, 21, 50));
+    Path expected, path;
+    for (LandmarkIndex::Selection selection : {LandmarkIndex::Selection::Farthest, LandmarkIndex::Selection::Avoid}) {
+        LandmarkIndex index(g, 6, selection);
+        CHECK(index.landmarks().size() == 6);
+        for (int dest = 0; dest < 300; dest += 7) {
+            INFO("selection ", static_cast<int>(selection), ", dest ", dest);
+            bool found = Algorithms::dijkstra(g, 3, dest, expected);
+            CHECK(index.query(g, 3, dest, path) == found);
+            CHECK(path.cost == expected.cost);
+            CHECK(index.lowerBound(3, SIZE_TYPE(dest)) <= (found ? expected.cost : LLONG_MAX));
+        }
+    }
+
+    // Landmarks at the grid's edges pull the search straight across
+    Graph grid = Generators::toGraph(Generators::grid2D(30, 30));
+    LandmarkIndex plain(grid, 0);
+    LandmarkIndex alt(grid, 4, LandmarkIndex::Selection::Farthest);
+    CHECK(plain.query(grid, 0, 899, path));
+    CHECK(alt.query(grid, 0, 899, expected));
+    CHECK(expected.cost == 58);
+    CHECK(alt.explored < plain.explored);
+
+    std::stringstream table;
+    table << alt;
+    LandmarkIndex loaded;
+    table >> loaded;
+    CHECK(loaded.landmarks() == alt.landmarks());
+    CHECK(loaded.query(grid.csr(), 0, 899, path));
+    CHECK(path.cost == 58);
+    CHECK(loaded.explored == alt.explored);
+
+    for (const char* text : {
+             "ALT 2\n1 0\n",                         // Unknown version
+             "ALT 1 4000000000 4000000000\n",        // Tables larger than memory
+             "ALT 1 4000000000 1\n0\n0: 0 0\n",      // Fewer rows than promised
+             "ALT 1\n2 0\n0:\n1:\n",                 // No landmarks
+             "ALT 1\n2 1\n0\n0: 1 0\n1: 1 1\n",      // Landmark 1 away from itself
+             "ALT 1\n2 1\n1\n0: 1 1\n1: 0 -1\n"}) {  // Landmark unreachable from itself
+        INFO(text);
+        std::stringstream bad(text);
+        CHECK_THROWS_AS(bad >> loaded, std::invalid_argument);
+    }
+    CHECK(loaded.landmarks() == alt.landmarks()); // A rejected table changes nothing
+    std::stringstream small("ALT 1\n2 1\n0\n0: 0 0\n1: 3 -1\n");
+    small >> loaded;
+    CHECK(loaded.landmarks() == std::vector<int>{0});
+    CHECK(loaded.lowerBound(0, 1) == 3);
+    CHECK_THROWS_AS(alt.query(g, 0, 1, path), std::invalid_argument);
+}
+
+TEST_CASE("Contraction hierarchy queries") {
+    Graph g = Generators::toGraph(Generators::erdosRenyi(200, 600, 31, 40));
+    Path expected, path;
+    for (size_t workers : {size_t(1), size_t(4)}) {
+        WorkerScope scope(workers);
+        ContractionHierarchy hierarchy(g);
+        for (int src = 0; src < 200; src += 37) {
+            for (int dest = 0; dest < 200; dest += 11) {
+                INFO("workers ", workers, ", src ", src, ", dest ", dest);
+                bool found = Algorithms::dijkstra(g, src, dest, expected);
+                CHECK(hierarchy.query(src, dest, path) == found);
+                CHECK(path.cost == expected.cost);
+                long long walked = 0;
+                for (size_t i = 1; i < path.vertices.size(); ++i) {
+                    int weight = g.getGraph()[SIZE_TYPE(path.vertices[i - 1])][SIZE_TYPE(path.vertices[i])];
+                    CHECK(weight != 0);
+                    walked += weight;
+                }
+                CHECK(walked == path.cost);
+                if (found) {
+                    CHECK(path.vertices.front() == src);
+                    CHECK(path.vertices.back() == dest);
+                }
+            }
+        }
+    }
+
+    // On a grid the hierarchy needs shortcuts and queries settle only a few vertices
+    Graph grid = Generators::toGraph(Generators::grid2D(30, 30));
+    ContractionHierarchy hierarchy(grid);
+    CHECK(hierarchy.shortcuts() > 0);
+    Path corner = hierarchy.query(0, 899);
+    CHECK(corner.cost == 58);
+    CHECK(corner.vertices.size() == 59);
+    CHECK(hierarchy.explored < 900);
+
+    std::stringstream file;
+    file << hierarchy;
+    ContractionHierarchy loaded;
+    file >> loaded;
+    CHECK(loaded.query(0, 899).vertices == corner.vertices);
+    CHECK(loaded.rank(17) == hierarchy.rank(17));
+    CHECK_THROWS_AS(loaded.query(0, 900), std::out_of_range);
+
+    // Hand-written files: 1 is contracted first, and 0 -> 2 is a shortcut over it
+    std::stringstream valid("CH 1\n3\n1 0 2\n0: 1 2 7 1 0\n1: 1 2 4 -1 1 0 3 -1\n2: 0 0\n");
+    valid >> loaded;
+    Path small = loaded.query(0, 2);
+    CHECK(small.vertices == std::vector<int>{0, 1, 2});
+    CHECK(small.cost == 7);
+    for (const char* text : {
+             "CH 1\n3\n1 0 2\n0: 1 2 7 1 0\n1: 0 0\n2: 0 0\n",                      // Shortcut halves missing
+             "CH 1\n3\n1 0 2\n0: 1 2 7 1 0\n1: 1 2 4 -1 0\n2: 0 0\n",               // One half missing
+             "CH 1\n3\n0 1 2\n0: 1 2 7 1 0\n1: 1 2 4 -1 0\n2: 0 0\n",               // Skipped vertex ranked too high
+             "CH 1\n3\n0 1 2\n0: 2 2 1 -1 1 1 -1 0\n1: 0 0\n2: 0 0\n",              // Arcs out of order
+             "CH 1\n3\n1 0 2\n0: 1 1 1 -1 0\n1: 0 0\n2: 0 0\n",                     // Up arc to a lower rank
+             "CH 1\n2\n0 0\n0: 0 0\n1: 0 0\n"}) {                                    // Repeated rank
+        std::stringstream broken(text);
+        CHECK_THROWS_AS(broken >> loaded, std::invalid_argument);
+    }
+    CHECK(loaded.query(0, 2).vertices == small.vertices); // A rejected file changes nothing
+
+    Graph negative;
+    negative.loadGraph({{0, -1}, {2, 0}});
+    CHECK_THROWS_AS(ContractionHierarchy{negative}, std::invalid_argument);
+}
+
+TEST_CASE("Batched multi-source BFS") {
+    Graph g = Generators::toGraph(Generators::erdosRenyi(400, 900, 17));
+    std::vector<std::pair<int, int>> queries;
+    for (int i = 0; i < 700; ++i) {
+        queries.emplace_back((i * 37) % 400, (i * 101 + 7) % 400); // 400 sources: more than one word
+    }
+    queries.emplace_back(5, 5);
+    std::vector<BFSTree> trees;
+    for (int src = 0; src < 400; ++src) {
+        trees.push_back(Algorithms::bfs(g, src));
+    }
+    for (size_t workers : {size_t(1), size_t(4)}) {
+        WorkerScope scope(workers);
+        std::vector<Path> paths = Algorithms::shortestPath(g, queries);
+        std::vector<bool> connected = Algorithms::isConnected(g, queries);
+        REQUIRE(paths.size() == queries.size());
+        for (size_t i = 0; i < queries.size(); ++i) {
+            auto [src, dest] = queries[i];
+            INFO("workers ", workers, ", src ", src, ", dest ", dest);
+            int depth = trees[SIZE_TYPE(src)].depth[SIZE_TYPE(dest)];
+            bool found = depth != -1;
+            CHECK(connected[i] == found);
+            CHECK(paths[i].found() == found);
+            CHECK(paths[i].cost == (found ? depth : 0));
+            for (size_t k = 1; k < paths[i].vertices.size(); ++k) {
+                CHECK(g.getGraph()[SIZE_TYPE(paths[i].vertices[k - 1])][SIZE_TYPE(paths[i].vertices[k])] != 0);
+            }
+            if (found) {
+                CHECK(paths[i].vertices.front() == src);
+                CHECK(paths[i].vertices.back() == dest);
+            }
+        }
+    }
+
+    // Weighted graphs fall back to one search per query
+    Graph weighted = Generators::toGraph(Generators::erdosRenyi(100, 400, 5, 20));
+    std::vector<Path> paths = Algorithms::shortestPath(weighted, {{0, 50}, {3, 3}, {99, 1}});
+    Path single;
+    CHECK(Algorithms::dijkstra(weighted, 0, 50, single) == paths[0].found());
+    CHECK(paths[0].cost == single.cost);
+    CHECK(paths[1].vertices == std::vector<int>{3});
+    CHECK_THROWS_AS(Algorithms::isConnected(weighted, {{0, 100}}), std::out_of_range);
+}
+
+TEST_CASE("Blocked Floyd-Warshall") {
+    // 200 vertices: two tiles per side, the last one padded
+    Graph g = Generators::toGraph(Generators::erdosRenyi(200, 900, 41, 30));
+    Path expected, path;
+    for (size_t workers : {size_t(1), size_t(4)}) {
+        WorkerScope scope(workers);
+        DistanceMatrix all = Algorithms::floydWarshall(g, true);
+        REQUIRE(all.vertices == 200);
+        for (int src = 0; src < 200; src += 19) {
+            for (int dest = 0; dest < 200; dest += 2) {
+                INFO("workers ", workers, ", src ", src, ", dest ", dest);
+                bool found = Algorithms::dijkstra(g, src, dest, expected);
+                long long d = all.at(SIZE_TYPE(src), SIZE_TYPE(dest));
+                CHECK(d == (found ? expected.cost : DistanceMatrix::UNREACHABLE));
+                CHECK(all.pathTo(SIZE_TYPE(src), SIZE_TYPE(dest), path) == found);
+                CHECK(path.cost == d * found);
+                long long walked = 0;
+                for (size_t i = 1; i < path.vertices.size(); ++i) {
+                    walked += g.getGraph()[SIZE_TYPE(path.vertices[i - 1])][SIZE_TYPE(path.vertices[i])];
+                }
+                CHECK(walked == path.cost);
+            }
+        }
+        CHECK(Algorithms::floydWarshall(g).distance == all.distance);
+        CHECK_THROWS_AS(Algorithms::floydWarshall(g).pathTo(0, 1, path), std::logic_error);
+    }
+
+    Graph negative;
+    negative.loadGraph({{0, 4, 0}, {0, 0, -2}, {0, 0, 0}});
+    DistanceMatrix small = Algorithms::floydWarshall(negative);
+    CHECK(small.at(0, 2) == 2);
+    CHECK(small.at(2, 0) == DistanceMatrix::UNREACHABLE);
+    negative.loadGraph({{0, 4, 0}, {0, 0, -2}, {-3, 0, 0}});
+    CHECK_THROWS_AS(Algorithms::floydWarshall(negative), std::invalid_argument);
+}
+
+TEST_CASE("Johnson all-pairs shortest paths") {
+    // Shifting every edge by p[u] - p[v] keeps cycle weights, so the graph gets negative
+    // edges but no negative cycle
+    std::vector<std::vector<int>> rows = Generators::toGraph(Generators::erdosRenyi(150, 600, 42, 20)).getGraph();
+    for (size_t u = 0; u < rows.size(); ++u) {
+        for (size_t v = 0; v < rows.size(); ++v) {
+            if (rows[u][v] != 0) { // A shifted weight of 0 drops the edge, which is harmless
+                rows[u][v] += static_cast<int>(u % 7) * 3 - static_cast<int>(v % 7) * 3;
+            }
+        }
+    }
+    Graph g;
+    g.loadGraph(rows);
+    DistanceMatrix expected = Algorithms::floydWarshall(g);
+    for (size_t workers : {size_t(1), size_t(4)}) {
+        WorkerScope scope(workers);
+        CHECK(Algorithms::johnson(g).distance == expected.distance);
+        size_t nextRow = 0;
+        Algorithms::johnson(g, [&](size_t source, std::span<const long long> row) {
+            INFO("workers ", workers, ", source ", source);
+            CHECK(source == nextRow++);
+            REQUIRE(row.size() == 150);
+            CHECK(std::equal(row.begin(), row.end(), expected.distance.begin() + static_cast<std::ptrdiff_t>(source * 150)));
+        });
+        CHECK(nextRow == 150);
+    }
+
+    Graph negative;
+    negative.loadGraph({{0, 4, 0}, {0, 0, -2}, {-3, 0, 0}});
+    bool called = false;
+    CHECK_THROWS_AS(Algorithms::johnson(negative, [&](size_t, std::span<const long long>) { called = true; }),
+                    std::invalid_argument);
+    CHECK_FALSE(called);
+    negative.loadGraph({{0, 4, 0}, {0, 0, -2}, {0, 0, 0}});
+    DistanceMatrix small = Algorithms::johnson(negative);
+    CHECK(small.at(0, 2) == 2);
+    CHECK(small.at(2, 0) == DistanceMatrix::UNREACHABLE);
+    CHECK(Johnson::potentials(negative.csr()) == vector<long long>({0, 0, -2}));
+}
+
+TEST_CASE("Bellman-Ford engine") {
+    // Negative edges without negative cycles, as in the Johnson test
+    std::vector<std::vector<int>> rows = Generators::toGraph(Generators::erdosRenyi(300, 1500, 43, 20)).getGraph();
+    for (size_t u = 0; u < rows.size(); ++u) {
+        for (size_t v = 0; v < rows.size(); ++v) {
+            if (rows[u][v] != 0) {
+                rows[u][v] += static_cast<int>(u % 5) * 4 - static_cast<int>(v % 5) * 4;
+            }
+        }
+    }
+    Graph g;
+    g.loadGraph(rows);
+    SparseIndex csr = g.csr();
+    DistanceMatrix expected = Algorithms::floydWarshall(g);
+    BellmanFord passes(BellmanFord::Strategy::Passes), queue(BellmanFord::Strategy::Queue);
+    for (size_t source : {size_t(0), size_t(17), size_t(299)}) {
+        REQUIRE(passes.run(csr, source));
+        REQUIRE(queue.run(csr, source));
+        for (size_t v = 0; v < 300; ++v) {
+            INFO("source ", source, ", vertex ", v);
+            CHECK(passes.distance[v] == expected.at(source, v));
+            CHECK(queue.distance[v] == expected.at(source, v));
+        }
+        // Early exit: far fewer than V passes
+        CHECK(passes.passes < 30);
+        CHECK(queue.passes < 30);
+    }
+    CHECK_FALSE(Algorithms::negativeCycle(g));
+
+    // A negative cycle 5->6->...->9->5 far from the source, behind a positive chain
+    std::vector<std::vector<int>> chain(12, std::vector<int>(12, 0));
+    for (size_t v = 0; v + 1 < 12; ++v) {
+        chain[v][v + 1] = 3;
+    }
+    chain[9][5] = -13;
+    Graph cyclic;
+    cyclic.loadGraph(chain);
+    CHECK_FALSE(passes.run(cyclic.csr(), 0));
+    CHECK_FALSE(queue.run(cyclic.csr(), 0));
+    CHECK(queue.passes <= 12);
+    CHECK(Algorithms::negativeCycle(cyclic));
+    CHECK(queue.run(cyclic.csr(), 10)); // The cycle is not reachable from 10
+    CHECK(queue.distance[11] == 3);
+    chain[9][5] = -12; // Cycle weight 0 is not negative
+    cyclic.loadGraph(chain);
+    CHECK_FALSE(Algorithms::negativeCycle(cyclic));
+
+    Graph loop;
+    loop.loadGraph({{0, 1}, {0, -1}});
+    CHECK(Algorithms::negativeCycle(loop));
+}
+
+TEST_CASE("Whole-graph negative cycle detection") {
+    // Weight of a reported cycle, or 0 if one of its edges is missing
+    auto cycleWeight = [](const Graph& graph, const std::vector<int>& cycle) {
+        long long total = 0;
+        for (size_t i = 0; i < cycle.size(); ++i) {
+            int weight = graph.getGraph()[SIZE_TYPE(cycle[i])][SIZE_TYPE(cycle[(i + 1) % cycle.size()])];
+            if (weight == 0) {
+                return 0LL;
+            }
+            total += weight;
+        }
+        return total;
+    };
+
+    // Vertex 0 cannot reach the cycle 2->3->4->2, which vertex-0 Bellman-Ford used to miss
+    Graph split;
+    split.loadGraph({{0, 5, 0, 0, 0},
+                     {0, 0, 0, 0, 0},
+                     {0, 0, 0, 2, 0},
+                     {0, 0, 0, 0, -4},
+                     {0, 0, 1, 0, 0}});
+    CHECK(Algorithms::negativeCycle(split));
+    std::optional<std::vector<int>> found = Algorithms::findNegativeCycle(split);
+    REQUIRE(found.has_value());
+    CHECK(found->size() == 3);
+    CHECK(cycleWeight(split, *found) == -1);
+
+    // Weights near INT_MAX must not overflow into a false cycle
+    Graph heavy;
+    heavy.loadGraph({{0, -INT_MAX, 0}, {0, 0, -INT_MAX}, {INT_MAX, 0, 0}});
+    CHECK(Algorithms::negativeCycle(heavy));
+    heavy.loadGraph({{0, INT_MAX, 0}, {0, 0, INT_MAX}, {-INT_MAX, 0, 0}});
+    CHECK_FALSE(Algorithms::findNegativeCycle(heavy).has_value());
+
+    // Every strategy, with a cycle planted among otherwise positive random edges
+    std::vector<std::vector<int>> rows = Generators::toGraph(Generators::erdosRenyi(400, 2400, 44, 50)).getGraph();
+    Graph g;
+    g.loadGraph(rows);
+    SparseIndex clean = g.csr();
+    rows[390][395] = -30;
+    rows[395][399] = -30;
+    rows[399][390] = 1;
+    Graph cyclic;
+    cyclic.loadGraph(rows);
+    SparseIndex planted = cyclic.csr();
+    std::vector<int> firstParents;
+    for (size_t workers : {size_t(1), size_t(4)}) {
+        WorkerScope scope(workers);
+        for (BellmanFord::Strategy strategy : {BellmanFord::Strategy::Passes, BellmanFord::Strategy::Queue,
+                                               BellmanFord::Strategy::Parallel}) {
+            INFO("workers ", workers, ", strategy ", static_cast<int>(strategy));
+            BellmanFord engine(strategy);
+            CHECK(engine.runFromAll(clean));
+            CHECK(std::all_of(engine.distance.begin(), engine.distance.end(), [](long long d) { return d == 0; }));
+            CHECK_FALSE(engine.runFromAll(planted));
+            CHECK(cycleWeight(cyclic, engine.cycle) < 0);
+            if (strategy == BellmanFord::Strategy::Parallel) {
+                // Ties go to the smallest predecessor whatever the worker count
+                REQUIRE(engine.run(clean, 0));
+                if (firstParents.empty()) {
+                    firstParents = engine.parent;
+                }
+                CHECK(engine.parent == firstParents);
+            }
+        }
+        std::optional<std::vector<int>> cycle = Algorithms::findNegativeCycle(cyclic);
+        REQUIRE(cycle.has_value());
+        CHECK(cycleWeight(cyclic, *cycle) < 0);
+    }
+}
+
+TEST_CASE("Parallel frontier Bellman-Ford") {
+    // 1000 vertices and 70000 edges: past BellmanFord::PARALLEL_MIN_EDGES, so several
+    // workers take the parallel rounds
+    std::vector<std::vector<int>> rows = Generators::toGraph(Generators::erdosRenyi(1000, 70000, 45, 40)).getGraph();
+    for (size_t u = 0; u < rows.size(); ++u) {
+        for (size_t v = 0; v < rows.size(); ++v) {
+            if (rows[u][v] != 0) {
+                rows[u][v] += static_cast<int>(u % 9) * 3 - static_cast<int>(v % 9) * 3;
+            }
+        }
+    }
+    Graph g;
+    g.loadGraph(rows);
+    ShortestPathTree reference;
+    {
+        WorkerScope one(1);
+        reference = Algorithms::bellmanFord(g, 3); // Sequential queue engine
+    }
+    std::vector<int> firstParents;
+    Path path;
+    for (size_t workers : {size_t(1), size_t(2), size_t(4)}) {
+        WorkerScope scope(workers);
+        BellmanFord engine(BellmanFord::Strategy::Parallel);
+        REQUIRE(engine.run(g.csr(), 3));
+        CHECK(engine.distance == reference.distance);
+        if (firstParents.empty()) {
+            firstParents = engine.parent;
+        }
+        CHECK(engine.parent == firstParents);
+
+        ShortestPathTree tree = Algorithms::bellmanFord(g, 3);
+        CHECK(tree.distance == reference.distance);
+        if (workers > 1) {
+            CHECK(tree.parent == firstParents);
+        }
+        for (size_t v = 0; v < 1000; v += 37) {
+            INFO("workers ", workers, ", vertex ", v);
+            REQUIRE(tree.pathTo(v, path));
+            long long walked = 0;
+            for (size_t i = 1; i < path.vertices.size(); ++i) {
+                walked += rows[SIZE_TYPE(path.vertices[i - 1])][SIZE_TYPE(path.vertices[i])];
+            }
+            CHECK(path.vertices.front() == 3);
+            CHECK(walked == tree.distance[v]);
+        }
+    }
+
+    Graph small;
+    small.loadGraph({{0, 4, 0, 0}, {0, 0, -2, 0}, {0, 0, 0, 0}, {0, 0, 0, -1}});
+    ShortestPathTree tree = Algorithms::bellmanFord(small, 0);
+    CHECK(tree.distance[2] == 2);
+    CHECK(tree.distance[3] == ShortestPathTree::UNREACHABLE); // Its negative loop is unreachable
+    CHECK_FALSE(tree.pathTo(3, path));
+    CHECK(tree.pathTo(2, path));
+    CHECK(path.toString() == "0->1->2");
+    CHECK_THROWS_AS(Algorithms::bellmanFord(small, 3), std::invalid_argument);
+    CHECK_THROWS_AS(Algorithms::bellmanFord(small, 4), std::out_of_range);
+}
+
+TEST_CASE("Minimum mean cycle") {
+    // Cycles 0->1->2->0 (mean 2), 3->4->3 (mean 3/2) and the self loop 5 (mean 4)
+    Graph g;
+    g.loadGraph({{0, 1, 0, 0, 0, 0},
+                 {0, 0, 2, 0, 0, 0},
+                 {3, 0, 0, 7, 0, 0},
+                 {0, 0, 0, 0, 1, 0},
+                 {0, 0, 0, 2, 0, 9},
+                 {0, 0, 0, 0, 0, 4}});
+    for (bool karp : {false, true}) {
+        std::optional<MeanCycle> cycle = Algorithms::minimumMeanCycle(g, karp);
+        REQUIRE(cycle.has_value());
+        std::vector<int> sorted = cycle->vertices;
+        std::sort(sorted.begin(), sorted.end());
+        CHECK(sorted == std::vector<int>{3, 4});
+        CHECK(cycle->weight == 3);
+        CHECK(cycle->numerator == 3);
+        CHECK(cycle->denominator == 2);
+        CHECK(cycle->mean() == 1.5);
+    }
+
+    Graph dag;
+    dag.loadGraph({{0, 1, -5}, {0, 0, 2}, {0, 0, 0}});
+    CHECK_FALSE(Algorithms::minimumMeanCycle(dag).has_value());
+    CHECK_FALSE(Algorithms::minimumMeanCycle(dag, true).has_value());
+
+    // Random graphs with negative weights: Howard and Karp agree on the exact mean
+    for (unsigned seed = 50; seed < 60; ++seed) {
+        INFO("seed ", seed);
+        std::vector<std::vector<int>> rows = Generators::toGraph(Generators::erdosRenyi(120, 300, seed, 40)).getGraph();
+        for (size_t u = 0; u < rows.size(); ++u) {
+            for (size_t v = 0; v < rows.size(); ++v) {
+                rows[u][v] = rows[u][v] == 0 ? 0 : rows[u][v] - 15;
+            }
+        }
+        Graph random;
+        random.loadGraph(rows);
+        std::optional<MeanCycle> howard = Algorithms::minimumMeanCycle(random);
+        std::optional<MeanCycle> karp = Algorithms::minimumMeanCycle(random, true);
+        REQUIRE(howard.has_value() == karp.has_value());
+        if (!howard) {
+            continue;
+        }
+        CHECK(howard->numerator == karp->numerator);
+        CHECK(howard->denominator == karp->denominator);
+        long long weight = 0;
+        for (size_t i = 0; i < howard->vertices.size(); ++i) {
+            int w = rows[SIZE_TYPE(howard->vertices[i])][SIZE_TYPE(howard->vertices[(i + 1) % howard->vertices.size()])];
+            CHECK(w != 0);
+            weight += w;
+        }
+        CHECK(weight == howard->weight);
+    }
+}
+
+TEST_CASE("Difference constraints") {
+    using Constraint = DifferenceConstraints::Constraint;
+    DifferenceConstraints system(4);
+    CHECK(system.add(Constraint{0, 1, 3}));  // x1 - x0 <= 3
+    CHECK(system.add(Constraint{1, 2, -2})); // x2 - x1 <= -2
+    CHECK(system.add(Constraint{2, 3, -1})); // x3 - x2 <= -1
+    CHECK(system.add(Constraint{0, 3, -5})); // x3 - x0 <= -5
+    const std::vector<long long>& x = system.assignment();
+    CHECK(x[1] - x[0] <= 3);
+    CHECK(x[2] - x[1] <= -2);
+    CHECK(x[3] - x[2] <= -1);
+    CHECK(x[3] - x[0] <= -5);
+    CHECK_FALSE(system.add(Constraint{3, 1, 2})); // x1 <= x3 + 2 closes 1->2->3->1 at -1
+    CHECK(system.conflict() == std::vector<int>{3, 1, 2});
+    CHECK(system.constraints() == 4);
+    CHECK(system.add(Constraint{3, 1, 3})); // Weight 0 around the loop is fine
+    CHECK_FALSE(system.add(Constraint{2, 2, -1}));
+    CHECK(system.conflict() == std::vector<int>{2});
+    CHECK_THROWS_AS(system.add(Constraint{0, 4, 1}), std::out_of_range);
+
+    // Random constraints one at a time; every rejection must come with a negative cycle,
+    // and the batch solver must agree on what is feasible
+    const size_t n = 60;
+    DifferenceConstraints incremental(n);
+    std::vector<Constraint> accepted;
+    std::vector<std::vector<long long>> tightest(n, std::vector<long long>(n, LLONG_MAX));
+    size_t rejected = 0;
+    for (int k = 0; k < 600; ++k) {
+        INFO("constraint ", k);
+        Constraint c{(k * 37 + 11) % 60, (k * 53 + k / 60 + 7) % 60, (k * 29) % 23 - 6};
+        if (incremental.add(c)) {
+            accepted.push_back(c);
+            auto& bound = tightest[SIZE_TYPE(c.from)][SIZE_TYPE(c.to)];
+            bound = std::min<long long>(bound, c.bound);
+            continue;
+        }
+        ++rejected;
+        const std::vector<int>& cycle = incremental.conflict();
+        long long total = 0;
+        for (size_t i = 0; i < cycle.size(); ++i) {
+            size_t from = SIZE_TYPE(cycle[i]), to = SIZE_TYPE(cycle[(i + 1) % cycle.size()]);
+            long long bound = tightest[from][to];
+            if (from == SIZE_TYPE(c.from) && to == SIZE_TYPE(c.to)) {
+                bound = std::min<long long>(bound, c.bound);
+            }
+            CHECK(bound != LLONG_MAX);
+            total += bound == LLONG_MAX ? 0 : bound;
+        }
+        CHECK(total < 0);
+
+        DifferenceConstraints batch(n);
+        std::vector<Constraint> withRejected = accepted;
+        withRejected.push_back(c);
+        CHECK_FALSE(batch.add(withRejected));
+        CHECK(batch.add(accepted));
+    }
+    CHECK(rejected > 0);
+    CHECK(incremental.constraints() == accepted.size());
+    for (const Constraint& c : accepted) {
+        INFO("constraint ", c.from, " -> ", c.to);
+        CHECK(incremental.assignment()[SIZE_TYPE(c.to)] - incremental.assignment()[SIZE_TYPE(c.from)] <= c.bound);
+    }
+}
+
+TEST_CASE("Minimum spanning forest") {
+    // Two components: a square with a diagonal, and a single edge; vertex 6 is isolated
+    Graph g;
+    g.loadGraph({{0, 1, 0, 4, 3, 0, 0},
+                 {1, 0, 2, 0, 0, 0, 0},
+                 {0, 2, 0, 5, 0, 0, 0},
+                 {4, 0, 5, 0, 0, 0, 0},
+                 {3, 0, 0, 0, 0, 0, 0},
+                 {0, 0, 0, 0, 0, 0, 0},
+                 {0, 0, 0, 0, 0, 0, 0}});
+    std::vector<std::tuple<int, int, int>> expected = {{0, 1, 1}, {0, 3, 4}, {0, 4, 3}, {1, 2, 2}};
+    for (SpanningMethod method : {SpanningMethod::Automatic, SpanningMethod::Boruvka, SpanningMethod::FilterKruskal,
+                                  SpanningMethod::Prim}) {
+        SpanningForest forest = Algorithms::minimumSpanningForest(g, method);
+        CHECK(forest.edges == expected);
+        CHECK(forest.weight == 10);
+        CHECK(forest.components == 3);
+    }
+
+    // Random graphs, including negative and asymmetric weights: every method finds a
+    // spanning forest of the same weight
+    std::vector<std::vector<int>> rows = Generators::toGraph(Generators::erdosRenyi(600, 5000, 46, 30)).getGraph();
+    for (size_t u = 0; u < rows.size(); u += 3) {
+        for (size_t v = 0; v < rows.size(); ++v) {
+            rows[u][v] = rows[u][v] == 0 ? 0 : rows[u][v] - 10;
+        }
+    }
+    Graph random;
+    random.loadGraph(rows);
+    std::optional<long long> weight;
+    for (size_t workers : {size_t(1), size_t(4)}) {
+        WorkerScope scope(workers);
+        for (SpanningMethod method : {SpanningMethod::Boruvka, SpanningMethod::FilterKruskal, SpanningMethod::Prim}) {
+            INFO("workers ", workers, ", method ", static_cast<int>(method));
+            SpanningForest forest = Algorithms::minimumSpanningForest(random, method);
+            if (!weight) {
+                weight = forest.weight;
+            }
+            CHECK(forest.weight == *weight);
+            UnionFind sets(600);
+            CHECK(forest.edges.size() + forest.components == 600);
+            long long total = 0;
+            for (const auto& [u, v, w] : forest.edges) {
+                int a = rows[SIZE_TYPE(u)][SIZE_TYPE(v)], b = rows[SIZE_TYPE(v)][SIZE_TYPE(u)];
+                CHECK(u < v);
+                CHECK(sets.unite(u, v));
+                CHECK(w == (a == 0 ? b : b == 0 ? a : std::min(a, b)));
+                total += w;
+            }
+            CHECK(total == forest.weight);
+            CHECK(forest.components == Algorithms::connectedComponents(random).count());
+        }
+    }
+}
+
+TEST_CASE("Strongly connected components") {
+    // {0, 1, 2} -> {3, 4}, and 5 on its own with a self-loop
+    Graph g;
+    g.loadGraph({{0, 1, 0, 0, 0, 0},
+                 {0, 0, 2, 0, 5, 0},
+                 {3, 0, 0, 7, 0, 0},
+                 {0, 0, 0, 0, 1, 0},
+                 {0, 0, 0, 1, 0, 0},
+                 {0, 0, 0, 0, 0, 4}});
+    for (ComponentMethod method : {ComponentMethod::Automatic, ComponentMethod::Tarjan, ComponentMethod::ForwardBackward}) {
+        Condensation condensation = Algorithms::stronglyConnectedComponents(g, method);
+        CHECK(condensation.components.label == std::vector<int>{0, 0, 0, 1, 1, 2});
+        CHECK(condensation.components.sizes == std::vector<size_t>{3, 2, 1});
+        // 2 -> 3 (7) and 1 -> 4 (5) both join the first two components; the lighter one stays
+        CHECK(condensation.dag.offsets == std::vector<size_t>{0, 1, 1, 1});
+        CHECK(condensation.dag.indices == std::vector<int>{1});
+        CHECK(condensation.dag.weights == std::vector<int>{5});
+    }
+
+    // Random directed graphs from sparse (mostly singletons) to one giant component:
+    // Tarjan agrees with mutual reachability, and forward-backward with Tarjan for any
+    // worker count, with and without the sequential finish
+    for (size_t m : {size_t(150), size_t(300), size_t(1200)}) {
+        Graph random = Generators::toGraph(Generators::erdosRenyi(300, m, m, 9));
+        SparseIndex out = random.csr();
+        SparseIndex in = random.csc();
+        std::vector<int> label = StronglyConnectedComponents::tarjan(out);
+        std::vector<std::vector<int>> depth(300);
+        for (size_t v = 0; v < 300; ++v) {
+            depth[v] = Algorithms::bfs(random, static_cast<int>(v)).depth;
+        }
+        for (size_t u = 0; u < 300; ++u) {
+            for (size_t v = 0; v < 300; ++v) {
+                INFO("edges ", m, ", u ", u, ", v ", v);
+                CHECK((label[u] == label[v]) == (depth[u][v] >= 0 && depth[v][u] >= 0));
+            }
+        }
+
+        for (size_t workers : {size_t(1), size_t(4)}) {
+            INFO("edges ", m, ", workers ", workers);
+            WorkerScope scope(workers);
+            CHECK(StronglyConnectedComponents::forwardBackward(out, in) == label);
+            CHECK(StronglyConnectedComponents::forwardBackward(out, in, 0) == label);
+        }
+
+        // The condensation is acyclic: each component stays alone in it, numbered as itself
+        Condensation condensation = Algorithms::stronglyConnectedComponents(random);
+        CHECK(condensation.components.label == label);
+        std::vector<int> dagLabel = StronglyConnectedComponents::tarjan(condensation.dag);
+        REQUIRE(dagLabel.size() == condensation.components.count());
+        for (size_t c = 0; c < dagLabel.size(); ++c) {
+            INFO("edges ", m, ", component ", c);
+            CHECK(dagLabel[c] == static_cast<int>(c));
+        }
+    }
+
+    // A 200000-vertex cycle with a tail n -> 0: no recursion depth limit
+    size_t n = 200000;
+    SparseIndex out, in;
+    out.offsets.push_back(0);
+    in.offsets = {0, 2};
+    in.indices = {static_cast<int>(n - 1), static_cast<int>(n)};
+    for (size_t v = 0; v <= n; ++v) {
+        out.indices.push_back(static_cast<int>((v + 1) % n));
+        out.offsets.push_back(v + 1);
+        if (v + 1 < n) {
+            in.indices.push_back(static_cast<int>(v)); // v -> v + 1
+        }
+        if (v < n) {
+            in.offsets.push_back(in.indices.size()); // End of vertex v + 1
+        }
+    }
+    out.weights.assign(out.indices.size(), 1);
+    in.weights.assign(in.indices.size(), 1);
+    std::vector<int> expected(n + 1, 0);
+    expected[n] = 1;
+    CHECK(StronglyConnectedComponents::tarjan(out) == expected);
+    CHECK(StronglyConnectedComponents::forwardBackward(out, in, 0) == expected);
+}
+
+TEST_CASE("Topological sort and DAG paths") {
+    // Jobs 0 and 1 start; 2 needs both, 3 needs 1, and 4 needs 2 and 3; 5 is independent
+    Graph jobs;
+    jobs.loadGraph({{0, 0, 4, 0, 0, 0},
+                    {0, 0, 1, 2, 0, 0},
+                    {0, 0, 0, 0, 3, 0},
+                    {0, 0, 0, 0, 6, 0},
+                    {0, 0, 0, 0, 0, 0},
+                    {0, 0, 0, 0, 0, 0}});
+    TopologicalOrder order = Algorithms::topologicalSort(jobs);
+    CHECK(order.acyclic());
+    CHECK(order.order == std::vector<int>{0, 1, 5, 2, 3, 4});
+    CHECK(order.level == std::vector<int>{0, 0, 1, 1, 2, 0});
+
+    ShortestPathTree shortest = Algorithms::dagShortestPaths(jobs, 1);
+    CHECK(shortest.distance == std::vector<long long>{ShortestPathTree::UNREACHABLE, 0, 1,
+                                                      2, 4, ShortestPathTree::UNREACHABLE});
+    ShortestPathTree longest = Algorithms::dagLongestPaths(jobs, 1);
+    CHECK(longest.distance[4] == 8);
+    Path path;
+    CHECK(longest.pathTo(4, path));
+    CHECK(path.vertices == std::vector<int>{1, 3, 4});
+    Path critical = Algorithms::criticalPath(jobs);
+    CHECK(critical.vertices == std::vector<int>{1, 3, 4});
+    CHECK(critical.cost == 8);
+    CHECK_THROWS_AS(Algorithms::dagShortestPaths(jobs, 6), std::out_of_range);
+
+    // Cycles are reported, including a self-loop, and the path queries refuse them
+    Graph cyclic;
+    cyclic.loadGraph({{0, 1, 0, 0},
+                      {0, 0, 1, 0},
+                      {0, 0, 0, 1},
+                      {0, 1, 0, 0}});
+    TopologicalOrder none = Algorithms::topologicalSort(cyclic);
+    CHECK_FALSE(none.acyclic());
+    CHECK(none.order.empty());
+    CHECK(none.cycle == std::vector<int>{1, 2, 3});
+    CHECK_THROWS_AS(Algorithms::dagLongestPaths(cyclic, 0), std::invalid_argument);
+    CHECK_THROWS_AS(Algorithms::criticalPath(cyclic), std::invalid_argument);
+    Graph loop;
+    loop.loadGraph({{0, 1}, {0, 2}});
+    CHECK(Algorithms::topologicalSort(loop).cycle == std::vector<int>{1});
+
+    // Random DAGs with negative weights: every edge points forward to a later level, the
+    // order is the same for any worker count, and the paths match Bellman-Ford (longest
+    // paths on the negated graph)
+    std::vector<std::vector<int>> rows = Generators::toGraph(Generators::erdosRenyi(400, 6000, 50, 9)).getGraph();
+    std::vector<std::vector<int>> negated(400, std::vector<int>(400, 0));
+    for (size_t u = 0; u < 400; ++u) {
+        for (size_t v = 0; v < 400; ++v) {
+            rows[u][v] = u >= v || rows[u][v] == 0 ? 0 : rows[u][v] - 4 + (rows[u][v] <= 4 ? -1 : 0);
+            negated[u][v] = -rows[u][v];
+        }
+    }
+    Graph dag, reversed;
+    dag.loadGraph(rows);
+    reversed.loadGraph(negated);
+    TopologicalOrder reference = Algorithms::topologicalSort(dag);
+    std::vector<size_t> position(400);
+    for (size_t i = 0; i < reference.order.size(); ++i) {
+        position[static_cast<size_t>(reference.order[i])] = i;
+    }
+    REQUIRE(reference.order.size() == 400);
+    for (size_t u = 0; u < 400; ++u) {
+        for (size_t v = 0; v < 400; ++v) {
+            if (rows[u][v] != 0) {
+                INFO("edge ", u, " -> ", v);
+                CHECK(position[u] < position[v]);
+                CHECK(reference.level[u] < reference.level[v]);
+            }
+        }
+    }
+    CHECK_FALSE(Algorithms::findNegativeCycle(dag).has_value());
+    for (size_t workers : {size_t(1), size_t(4)}) {
+        WorkerScope scope(workers);
+        TopologicalOrder again = Algorithms::topologicalSort(dag);
+        CHECK(again.order == reference.order);
+        CHECK(again.level == reference.level);
+        for (int source : {0, 17, 200}) {
+            CHECK(Algorithms::dagShortestPaths(dag, source).distance == Algorithms::bellmanFord(dag, source).distance);
+            std::vector<long long> longest = Algorithms::dagLongestPaths(dag, source).distance;
+            std::vector<long long> viaNegated = Algorithms::bellmanFord(reversed, source).distance;
+            for (size_t v = 0; v < 400; ++v) {
+                INFO("workers ", workers, ", source ", source, ", vertex ", v);
+                if (longest[v] == ShortestPathTree::UNREACHABLE) {
+                    CHECK(viaNegated[v] == ShortestPathTree::UNREACHABLE);
+                } else {
+                    CHECK(longest[v] == -viaNegated[v]);
+                }
+            }
+        }
+    }
+}
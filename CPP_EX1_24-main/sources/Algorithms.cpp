@@ -1,11 +1,27 @@
 #include "Algorithms.hpp"
+#include "BellmanFord.hpp"
+#include "BFSEngine.hpp"
+#include "Bidirectional.hpp"
+#include "DeltaStepping.hpp"
+#include "Dijkstra.hpp"
+#include "FloydWarshall.hpp"
+#include "Johnson.hpp"
+#include "MeanCycle.hpp"
+#include "MultiSourceBFS.hpp"
+#include "Parallel.hpp"
+#include "SpanningForest.hpp"
+#include "StronglyConnected.hpp"
+#include "Topological.hpp"
+#include "UnionFind.hpp"
+#include <atomic>
 #include <stack>
 #include <queue>
 #include <algorithm>
-#include <functional>
 #include <sstream>
 #include <tuple>
 #include <climits>
+#include <stdexcept>
+#include <utility>
 #include <iostream> // Include for debug prints
 
 using namespace std;
@@ -13,255 +29,774 @@ using namespace std;
 namespace ariel {
 
 #include <iostream> // Include for debug prints
+
+    namespace {
+        std::size_t checkedVertex(int vertex, std::size_t numVertices) {
+            if (vertex < 0 || static_cast<std::size_t>(vertex) >= numVertices) {
+                throw std::out_of_range("Vertex index out of range");
+            }
+            return static_cast<std::size_t>(vertex);
+        }
+
+        // One engine per thread keeps its buffers warm across calls, so repeated queries on
+        // graphs of the same size do not allocate
+        BFSEngine& threadEngine() {
+            thread_local BFSEngine engine;
+            return engine;
+        }
+
+        DijkstraEngine& threadDijkstra(DijkstraEngine::HeapKind heap) {
+            thread_local DijkstraEngine radix(DijkstraEngine::HeapKind::Radix);
+            thread_local DijkstraEngine dary(DijkstraEngine::HeapKind::DAry);
+            return heap == DijkstraEngine::HeapKind::Radix ? radix : dary;
+        }
+
+        BidirectionalSearch& threadBidirectional() {
+            thread_local BidirectionalSearch search;
+            return search;
+        }
+
+        enum class WeightKind { Unit, NonNegative, Negative };
+
+        // One pass over the matrix; stops at the first negative weight
+        WeightKind classifyWeights(const std::vector<std::vector<int>>& rows) {
+            WeightKind kind = WeightKind::Unit;
+            for (const std::vector<int>& row : rows) {
+                for (int weight : row) {
+                    if (weight < 0) {
+                        return WeightKind::Negative;
+                    }
+                    if (weight > 1) {
+                        kind = WeightKind::NonNegative;
+                    }
+                }
+            }
+            return kind;
+        }
+
+        BellmanFord& threadBellmanFord(BellmanFord::Strategy strategy = BellmanFord::Strategy::Queue) {
+            thread_local BellmanFord queue(BellmanFord::Strategy::Queue);
+            thread_local BellmanFord parallel(BellmanFord::Strategy::Parallel);
+            return strategy == BellmanFord::Strategy::Parallel ? parallel : queue;
+        }
+
+        // Sequential queue-based engine for small graphs, parallel rounds for large ones
+        BellmanFord& chooseBellmanFord(const SparseIndex& index) {
+            bool parallel = workerCount() > 1 && index.nonZeros() >= BellmanFord::PARALLEL_MIN_EDGES;
+            return threadBellmanFord(parallel ? BellmanFord::Strategy::Parallel : BellmanFord::Strategy::Queue);
+        }
+
+        // Bellman-Ford (queue-based, see BellmanFord) for graphs with negative weights. Stays
+        // sequential: batched queries already run one search per worker.
+        bool bellmanFordPath(const Graph& graph, size_t source, size_t target, Path& out) {
+            BellmanFord& engine = threadBellmanFord();
+            bool valid = engine.run(graph.csr(), source);
+            out.vertices.clear();
+            out.cost = 0;
+            if (!valid || engine.distance[target] == BellmanFord::UNREACHABLE) {
+                return false;
+            }
+            for (size_t v = target; v != source; v = static_cast<size_t>(engine.parent[v])) {
+                out.vertices.push_back(static_cast<int>(v));
+            }
+            out.vertices.push_back(static_cast<int>(source));
+            std::reverse(out.vertices.begin(), out.vertices.end());
+            out.cost = engine.distance[target];
+            return true;
+        }
+
+        // Aim for this many matrix cells per worker chunk in row-parallel scans
+        constexpr std::size_t SCAN_GRAIN_CELLS = 1 << 16;
+
+        std::size_t rowsPerChunk(std::size_t n) {
+            return std::max<std::size_t>(1, SCAN_GRAIN_CELLS / std::max<std::size_t>(1, n));
+        }
+
+        // Neighbor-sampling rounds before the giant component is identified
+        constexpr int AFFOREST_ROUNDS = 2;
+        // Vertices inspected to guess the giant component
+        constexpr std::size_t AFFOREST_SAMPLES = 1024;
+
+        // Afforest (Sutton et al.): union each vertex with its first few neighbors, guess the
+        // largest component from a sample, then finish only the vertices outside it. For
+        // asymmetric matrices the finishing pass also scans in-edges, because an edge whose
+        // source sits in the skipped component is only stored in that source's row.
+        // Returns the number of successful unions; with stopWhenConnected it returns as soon
+        // as n - 1 unions (a single component) are reached.
+        std::size_t linkComponents(const std::vector<std::vector<int>>& rows, UnionFind& sets, bool symmetric,
+                                   bool stopWhenConnected) {
+            std::size_t n = rows.size();
+            std::atomic<std::size_t> unions{0};
+            auto connected = [&]() {
+                return stopWhenConnected && unions.load(std::memory_order_relaxed) + 1 >= n;
+            };
+            std::vector<std::size_t> cursor(n, 0); // First column of each row not yet linked
+
+            for (int round = 0; round < AFFOREST_ROUNDS && !connected(); ++round) {
+                parallelFor(n, rowsPerChunk(n), [&](std::size_t begin, std::size_t end, std::size_t) {
+                    std::size_t linked = 0;
+                    for (std::size_t u = begin; u < end; ++u) {
+                        const std::vector<int>& row = rows[u];
+                        std::size_t j = cursor[u];
+                        while (j < n && row[j] == 0) {
+                            ++j;
+                        }
+                        if (j < n && sets.unite(static_cast<int>(u), static_cast<int>(j))) {
+                            ++linked;
+                        }
+                        cursor[u] = std::min(n, j + 1);
+                    }
+                    unions.fetch_add(linked, std::memory_order_relaxed);
+                });
+                sets.compress();
+            }
+            if (connected()) {
+                return unions.load();
+            }
+
+            // The most frequent root among evenly spread samples is almost surely the giant
+            std::vector<std::size_t> votes(n, 0);
+            int giant = 0;
+            std::size_t samples = std::min(n, AFFOREST_SAMPLES);
+            for (std::size_t k = 0; k < samples; ++k) {
+                int root = sets.find(static_cast<int>(k * n / samples));
+                if (++votes[static_cast<std::size_t>(root)] > votes[static_cast<std::size_t>(giant)]) {
+                    giant = root;
+                }
+            }
+
+            parallelFor(n, rowsPerChunk(n), [&](std::size_t begin, std::size_t end, std::size_t) {
+                std::size_t linked = 0;
+                for (std::size_t u = begin; u < end && !connected(); ++u) {
+                    int vertex = static_cast<int>(u);
+                    if (sets.find(vertex) == giant) {
+                        continue;
+                    }
+                    const std::vector<int>& row = rows[u];
+                    for (std::size_t j = cursor[u]; j < n; ++j) {
+                        if (row[j] != 0 && sets.unite(vertex, static_cast<int>(j))) {
+                            ++linked;
+                        }
+                    }
+                    if (!symmetric) {
+                        for (std::size_t w = 0; w < n; ++w) {
+                            if (rows[w][u] != 0 && sets.unite(static_cast<int>(w), vertex)) {
+                                ++linked;
+                            }
+                        }
+                    }
+                    unions.fetch_add(linked, std::memory_order_relaxed);
+                    linked = 0;
+                }
+            });
+            return unions.load();
+        }
+
+        // Group queries by source into passes of at most MAX_SOURCES distinct sources, run a
+        // multi-source BFS per pass and hand each query its engine and slot.
+        template <typename Answer>
+        void batchBFS(const Graph& graph, const std::vector<std::pair<int, int>>& queries, bool trackParents,
+                      const Answer& answer) {
+            size_t numVertices = graph.vertices();
+            std::vector<size_t> order(queries.size());
+            for (size_t i = 0; i < queries.size(); ++i) {
+                checkedVertex(queries[i].first, numVertices);
+                checkedVertex(queries[i].second, numVertices);
+                order[i] = i;
+            }
+            std::sort(order.begin(), order.end(),
+                      [&](size_t a, size_t b) { return queries[a].first < queries[b].first; });
+
+            thread_local MultiSourceBFS engine;
+            std::vector<size_t> sources;
+            std::vector<size_t> slots(queries.size());
+            std::vector<std::pair<size_t, size_t>> goals;
+            for (size_t begin = 0; begin < order.size();) {
+                sources.clear();
+                goals.clear();
+                size_t end = begin;
+                for (; end < order.size(); ++end) {
+                    size_t source = static_cast<size_t>(queries[order[end]].first);
+                    if (sources.empty() || sources.back() != source) {
+                        if (sources.size() == MultiSourceBFS::MAX_SOURCES) {
+                            break;
+                        }
+                        sources.push_back(source);
+                    }
+                    slots[order[end]] = sources.size() - 1;
+                    goals.emplace_back(sources.size() - 1, static_cast<size_t>(queries[order[end]].second));
+                }
+                engine.run(DenseAdjacency(graph), sources, goals, trackParents);
+                for (size_t i = begin; i < end; ++i) {
+                    answer(engine, order[i], slots[order[i]]);
+                }
+                begin = end;
+            }
+        }
+
+        TopologicalOrder checkedOrder(const SparseIndex &out) {
+            TopologicalOrder order = TopologicalSort::run(out);
+            if (!order.acyclic()) {
+                throw std::invalid_argument("Graph contains a directed cycle");
+            }
+            return order;
+        }
+
+        ShortestPathTree dagPaths(const Graph &graph, int src, bool longest) {
+            SparseIndex out = graph.csr();
+            size_t source = checkedVertex(src, out.vertices());
+            ShortestPathTree tree;
+            tree.source = source;
+            TopologicalSort::paths(graph.csc(), checkedOrder(out), source, longest, tree.distance, tree.parent);
+            return tree;
+        }
+    } // namespace
+
 //this function to check whether a graph is connected.
-// You start by checking if the graph is empty,
-// in which case you return true. Otherwise,
-// you perform a breadth-first search (BFS) traversal starting from vertex 0.
-// During the BFS traversal, you mark visited vertices using a boolean array.
-// If all vertices are visited, you conclude that the graph is connected.
+// An empty graph is connected. An undirected graph is connected when the union-find
+// pass reaches n - 1 successful unions, at which point it stops. A directed graph
+// keeps the original meaning: a BFS from vertex 0 must reach every vertex.
     bool Algorithms::isConnected(Graph &graph) {
         size_t numVertices = graph.vertices();
         if (numVertices == 0) {
             return true;
         }
 
-        std::vector<bool> visited(numVertices, false);
-        std::queue<int> q;
-        q.push(0); // Start BFS from node 0
-        visited[0] = true; // Mark the starting node as visited
-        while (!q.empty()) {
-            int node = q.front();
-            q.pop();
-            for (std::size_t adjacent = 0; adjacent < graph.vertices(); ++adjacent) {
-                if (graph.adj(node)[adjacent] != 0) { // There is an edge
-                    if (!visited[adjacent]) {
-                        visited[adjacent] = true;
-                        q.push(static_cast<int>(adjacent));
-                    }
-                }
-            }
+        const std::vector<std::vector<int>>& rows = graph.getGraph();
+        if (!graph.isDirected()) {
+            UnionFind sets(numVertices);
+            return linkComponents(rows, sets, true, true) + 1 == numVertices;
         }
+        return threadEngine().run(DenseAdjacency(graph), 0) == numVertices;
+    }
 
-        // Check if all vertices were visited
-        bool allVisited = true;
-        for (size_t i = 0; i < numVertices; ++i) {
-            if (!visited[i]) {
-                allVisited = false;
+    std::vector<bool> Algorithms::isConnected(const Graph &graph, const std::vector<std::pair<int, int>> &queries) {
+        std::vector<bool> connected(queries.size(), false);
+        batchBFS(graph, queries, false, [&](const MultiSourceBFS& engine, size_t query, size_t slot) {
+            connected[query] = engine.reached(slot, static_cast<size_t>(queries[query].second));
+        });
+        return connected;
+    }
+
+    // Roots of the union-find are the smallest member of each set, so numbering roots in
+    // vertex order gives component ids ordered by their smallest vertex.
+    Components Algorithms::connectedComponents(const Graph &graph) {
+        const std::vector<std::vector<int>>& rows = graph.getGraph();
+        size_t numVertices = graph.vertices();
+        UnionFind sets(numVertices);
+        linkComponents(rows, sets, !graph.isDirected(), false);
+        sets.compress();
+
+        Components components;
+        components.label.assign(numVertices, -1);
+        for (size_t v = 0; v < numVertices; ++v) {
+            size_t root = static_cast<size_t>(sets.parentOf(static_cast<int>(v)));
+            if (root == v) {
+                components.label[v] = static_cast<int>(components.sizes.size());
+                components.sizes.push_back(0);
             }
+            components.label[v] = components.label[root];
+            ++components.sizes[static_cast<size_t>(components.label[v])];
         }
-        return allVisited;
+        return components;
     }
+    Condensation Algorithms::stronglyConnectedComponents(const Graph &graph, ComponentMethod method) {
+        SparseIndex out = graph.csr();
+        if (method == ComponentMethod::Automatic) {
+            bool parallel = workerCount() > 1 && out.nonZeros() >= StronglyConnectedComponents::PARALLEL_MIN_EDGES;
+            method = parallel ? ComponentMethod::ForwardBackward : ComponentMethod::Tarjan;
+        }
+        Condensation condensation;
+        Components& components = condensation.components;
+        components.label = method == ComponentMethod::Tarjan ? StronglyConnectedComponents::tarjan(out)
+                                                             : StronglyConnectedComponents::forwardBackward(out, graph.csc());
+        for (int label : components.label) {
+            // Labels are numbered in order of first appearance
+            if (static_cast<size_t>(label) == components.sizes.size()) {
+                components.sizes.push_back(0);
+            }
+            ++components.sizes[static_cast<size_t>(label)];
+        }
+        condensation.dag = StronglyConnectedComponents::condense(out, components.label, components.count());
+        return condensation;
+    }
+
+    TopologicalOrder Algorithms::topologicalSort(const Graph &graph) {
+        return TopologicalSort::run(graph.csr());
+    }
+
 //This function detects whether the given graph contains a cycle.
-// You've implemented it using a depth-first search (DFS) traversal.
-// Within the DFS traversal, you maintain two boolean arrays:
-// one for visited vertices and another to track vertices in the recursion stack.
-// If you encounter a visited vertex that is also in the recursion stack, you've detected a cycle.
+// It is a thin wrapper over findCycle; callers that need the cycle itself use that.
     bool Algorithms::isContainsCycle(Graph &graph) {
+        return findCycle(graph).has_value();
+    }
+
+// The graph's declared or detected direction picks the engine once, up front.
+    std::optional<std::vector<int>> Algorithms::findCycle(const Graph &graph) {
+        return graph.isDirected() ? findDirectedCycle(graph) : findUndirectedCycle(graph);
+    }
+
+// Union-find over the pairs {i, j} with i <= j; a pair is an edge if either direction is
+// stored, so asymmetric matrices are read as undirected. A forest has at most V - 1 edges, so the
+// first edge whose endpoints are already joined closes a cycle and at most V unions are
+// attempted. The cycle is that edge plus the forest path between its endpoints, found
+// by a BFS restricted to the forest edges kept so far.
+    std::optional<std::vector<int>> Algorithms::findUndirectedCycle(const Graph &graph) {
+        const std::vector<std::vector<int>>& rows = graph.getGraph();
         size_t numVertices = graph.vertices();
-        std::vector<bool> visited(numVertices, false);
-        std::vector<bool> recStack(numVertices, false);
-        std::vector<int> parent(numVertices, -1);
-        std::vector<int> cyclePath;
-
-        std::function<bool(int, int)> dfs = [&](int v, int parentV) {
-            visited[static_cast<std::size_t>(v)] = true;
-            recStack[static_cast<std::size_t>(v)] = true;
-            for (std::size_t neighbor = 0; neighbor < graph.adj(v).size(); ++neighbor) {
-                if (graph.adj(v)[neighbor] != 0) { // There is an edge
-                    if (!visited[neighbor]) {
-                        parent[neighbor] = v;
-                        if (dfs(static_cast<int>(neighbor), v)) {
-                            return true;
-                        }
-                    } else if (neighbor != static_cast<std::size_t>(parentV) && recStack[neighbor]) { // Check for a cycle
-                        // Capture the cycle path
-                        for (int current = v; current != static_cast<int>(neighbor); current = parent[static_cast<std::size_t>(current)]) {
-                            cyclePath.push_back(current);
+        UnionFind sets(numVertices);
+        std::vector<std::vector<int>> forest(numVertices);
+
+        for (size_t i = 0; i < numVertices; ++i) {
+            for (size_t j = i; j < numVertices; ++j) {
+                if (rows[i][j] == 0 && rows[j][i] == 0) {
+                    continue;
+                }
+                int u = static_cast<int>(i);
+                int v = static_cast<int>(j);
+                if (sets.unite(u, v)) {
+                    forest[i].push_back(v);
+                    forest[j].push_back(u);
+                    continue;
+                }
+
+                // u and v are already connected in the forest: walk the tree path v ... u
+                std::vector<int> parent(numVertices, -1);
+                std::vector<int> queue = {u};
+                parent[i] = u;
+                for (size_t head = 0; head < queue.size() && parent[j] == -1; ++head) {
+                    for (int next : forest[static_cast<size_t>(queue[head])]) {
+                        if (parent[static_cast<size_t>(next)] == -1) {
+                            parent[static_cast<size_t>(next)] = queue[head];
+                            queue.push_back(next);
                         }
-                        cyclePath.push_back(static_cast<int>(neighbor));
-                        cyclePath.push_back(v);
-                        std::reverse(cyclePath.begin(), cyclePath.end());
-                        return true;
                     }
                 }
+                std::vector<int> cycle;
+                for (int current = v; current != u; current = parent[static_cast<size_t>(current)]) {
+                    cycle.push_back(current);
+                }
+                cycle.push_back(u);
+                std::reverse(cycle.begin(), cycle.end());
+                return cycle;
             }
-            recStack[static_cast<std::size_t>(v)] = false;
-            return false;
-        };
+        }
+        return std::nullopt;
+    }
 
-        for (size_t i = 0; i < numVertices; ++i) {
-            if (!visited[i]) {
-                if (dfs(static_cast<int>(i), -1)) {
-                    std::cout << "The cycle is: ";
-                    for (size_t j = 0; j < cyclePath.size(); ++j) {
-                        if (j > 0) std::cout << "->";
-                        std::cout << cyclePath[j];
+// Three-color depth-first search with an explicit stack instead of recursion, so path
+// length is bounded by memory rather than by the call stack. next[v] remembers where the
+// scan of v's row stopped, which lets a vertex resume after its child finishes. All state
+// lives in arrays sized once per call.
+// Gray (on the stack) vertices form the current path; an edge into a gray vertex closes a cycle.
+    std::optional<std::vector<int>> Algorithms::findDirectedCycle(const Graph &graph) {
+        enum Color : char { WHITE, GRAY, BLACK };
+        const std::vector<std::vector<int>>& rows = graph.getGraph();
+        size_t numVertices = graph.vertices();
+        std::vector<int> parent(numVertices, -1);
+        std::vector<size_t> next(numVertices, 0);
+        std::vector<Color> color(numVertices, WHITE);
+        std::vector<int> stack;
+        stack.reserve(numVertices);
+
+        for (size_t root = 0; root < numVertices; ++root) {
+            if (color[root] != WHITE) {
+                continue;
+            }
+            color[root] = GRAY;
+            stack.push_back(static_cast<int>(root));
+            while (!stack.empty()) {
+                size_t v = static_cast<size_t>(stack.back());
+                const std::vector<int>& row = rows[v];
+                size_t& neighbor = next[v];
+                while (neighbor < numVertices && row[neighbor] == 0) {
+                    ++neighbor;
+                }
+                if (neighbor == numVertices) { // Row exhausted: v is finished
+                    color[v] = BLACK;
+                    stack.pop_back();
+                    continue;
+                }
+                size_t u = neighbor++;
+                if (color[u] == WHITE) {
+                    color[u] = GRAY;
+                    parent[u] = static_cast<int>(v);
+                    stack.push_back(static_cast<int>(u));
+                } else if (color[u] == GRAY) {
+                    // Back edge v->u: the tree path u ... v plus this edge is the cycle
+                    std::vector<int> cycle;
+                    for (int current = static_cast<int>(v); current != static_cast<int>(u);
+                         current = parent[static_cast<size_t>(current)]) {
+                        cycle.push_back(current);
                     }
-                    std::cout << std::endl;
-                    return true;
+                    cycle.push_back(static_cast<int>(u));
+                    std::reverse(cycle.begin(), cycle.end());
+                    return cycle;
                 }
             }
         }
-        return false;
+        return std::nullopt;
     }
 
 
 //Here, i implemented a function to determine whether the graph is bipartite.
-// You've used BFS traversal with vertex coloring. During the traversal,
-// you assign alternating colors (0 and 1) to adjacent vertices.
-// If any adjacent vertices have the same color,the graph is not bipartite.
+// The string form is produced on demand from the typed Bipartition.
     std::string Algorithms::isBipartite(Graph &graph) {
+        Bipartition result;
+        bipartition(graph, result);
+        return result.toString();
+    }
+
+// Each BFS tree is colored by depth parity (0 and 1 alternate by level), using the
+// shared BFS engine, which goes parallel on large levels.
+// If any edge joins two vertices of the same color, the graph is not bipartite.
+    bool Algorithms::bipartition(const Graph &graph, Bipartition &out) {
         size_t numVertices = graph.vertices();
-        vector<int> color(numVertices, -1); // -1 means uncolored
-        queue<size_t> q; // Use size_t for queue indices
-        bool isBipartite = true;
+        std::vector<int>& color = out.color;
+        color.assign(numVertices, -1); // -1 means uncolored
 
-        // Perform BFS traversal for each uncolored vertex
+        // Color every BFS tree by depth parity, one tree per still-uncolored vertex
+        BFSEngine& engine = threadEngine();
+        DenseAdjacency adjacency(graph);
         for (size_t i = 0; i < numVertices; i++) {
             if (color[i] == -1) { // Node not colored yet
-                color[i] = 0; // Assign color 0
-                q.push(i);
-                // BFS traversal to color vertices and check bipartiteness
-                while (!q.empty() && isBipartite) {
-                    size_t u = q.front();
-                    q.pop();
-                    // Iterate over adjacent vertices
-                    for (size_t v = 0; v < numVertices; ++v) {
-                        // Check if there is an edge between u and v
-                        if (graph.adj(u)[v] != 0) {
-                            if (color[v] == -1) { // Node not colored
-                                color[v] = 1 - color[u]; // Assign opposite color
-                                q.push(v);
-                            } else if (color[v] == color[u]) { // Same color as parent
-                                isBipartite = false;
-                                break;
-                            }
-                        }
+                engine.run(adjacency, i);
+                for (size_t v = 0; v < numVertices; ++v) {
+                    if (color[v] == -1 && engine.depth[v] != -1) {
+                        color[v] = engine.depth[v] % 2;
                     }
                 }
-                if (!isBipartite) break; // Exit if not bipartite
             }
         }
 
-        if (!isBipartite) {
-            return "0"; // Return 0 if not bipartite
-        }
-
-        // Construct the bipartite sets string
-        vector<int> setA, setB;
-        for (size_t i = 0; i < numVertices; ++i) {
-            if (color[i] == 0) {
-                setA.push_back(static_cast<int>(i));
-            } else if (color[i] == 1) {
-                setB.push_back(static_cast<int>(i));
+        // The coloring is proper iff no edge joins two vertices of the same color
+        const std::vector<std::vector<int>>& rows = graph.getGraph();
+        std::atomic<bool> conflict{false};
+        parallelFor(numVertices, rowsPerChunk(numVertices), [&](size_t begin, size_t end, size_t) {
+            for (size_t u = begin; u < end && !conflict.load(std::memory_order_relaxed); ++u) {
+                for (size_t v = 0; v < numVertices; ++v) {
+                    if (rows[u][v] != 0 && color[u] == color[v]) {
+                        conflict.store(true, std::memory_order_relaxed);
+                        break;
+                    }
+                }
             }
-        }
+        });
 
-        std::sort(setA.begin(), setA.end());
-        std::sort(setB.begin(), setB.end());
+        out.bipartite = !conflict.load();
+        if (!out.bipartite) {
+            color.clear();
+        }
+        return out.bipartite;
+    }
 
-        // Construct the result string
-        stringstream ss;
+// Vertices are listed in increasing order, so no sorting is needed
+    std::string Bipartition::toString() const {
+        if (!bipartite) {
+            return "0"; // Return 0 if not bipartite
+        }
+        std::stringstream ss;
         ss << "The graph is bipartite: A={";
-        for (size_t i = 0; i < setA.size(); ++i) {
-            if (i > 0) ss << ", ";
-            ss << setA[i];
+        const char* separator = "";
+        for (size_t i = 0; i < color.size(); ++i) {
+            if (color[i] == 0) {
+                ss << separator << i;
+                separator = ", ";
+            }
         }
         ss << "}, B={";
-        for (size_t i = 0; i < setB.size(); ++i) {
-            if (i > 0) ss << ", ";
-            ss << setB[i];
+        separator = "";
+        for (size_t i = 0; i < color.size(); ++i) {
+            if (color[i] == 1) {
+                ss << separator << i;
+                separator = ", ";
+            }
         }
         ss << "}";
         return ss.str(); // Return the result string
     }
-//This function finds the shortest path between two vertices using BFS traversal.
-// Starting from the source vertex, you explore the graph layer by layer until you reach the destination vertex.
-// You maintain a parent array to reconstruct the shortest path once the destination is reached.
+
+//This function finds the lightest path between two vertices.
+// The string form is produced on demand from the typed Path.
     std::string Algorithms::shortestPath(Graph& graph, int src, int dest) {
-        size_t numVertices = graph.vertices();
-        std::vector<int> parent(numVertices, -1); // Parent array to reconstruct the shortest path
-        std::vector<bool> visited(numVertices, false); // Visited array to mark visited vertices
-        std::queue<int> q; // Queue for BFS traversal
+        Path path;
+        shortestPath(graph, src, dest, path);
+        return path.toString();
+    }
 
-        q.push(src); // Start BFS from source vertex
-        visited[static_cast<std::vector<bool>::size_type>(src)] = true; // Mark the source vertex as visited
+// The weights decide the engine: bidirectional BFS for unit weights, bidirectional Dijkstra
+// when nothing is negative, Bellman-Ford otherwise. The bidirectional searches grow one tree
+// from src and one towards dest and stop as soon as the trees provably meet on a lightest path.
+    bool Algorithms::shortestPath(const Graph &graph, int src, int dest, Path &out) {
+        size_t numVertices = graph.vertices();
+        size_t source = checkedVertex(src, numVertices);
+        size_t target = checkedVertex(dest, numVertices);
+        out.vertices.clear();
+        out.cost = 0;
 
-        // Perform BFS traversal
-        while (!q.empty()) {
-            int u = q.front();
-            q.pop();
+        WeightKind weights = classifyWeights(graph.getGraph());
+        if (weights == WeightKind::Negative) {
+            return bellmanFordPath(graph, source, target, out);
+        }
+        BidirectionalSearch& search = threadBidirectional();
+        if (weights == WeightKind::Unit) {
+            return search.bfs(DenseAdjacency(graph), source, target, out);
+        }
+        return search.dijkstra(DenseAdjacency(graph), source, target, out);
+    }
 
-            if (u == dest) {
-                break; // If destination is reached, exit the loop
-            }
+    std::vector<Path> Algorithms::shortestPath(const Graph &graph, const std::vector<std::pair<int, int>> &queries) {
+        std::vector<Path> paths(queries.size());
+        WeightKind weights = classifyWeights(graph.getGraph());
+        if (weights == WeightKind::Unit) {
+            size_t numVertices = graph.vertices();
+            batchBFS(graph, queries, true, [&](const MultiSourceBFS& engine, size_t query, size_t slot) {
+                size_t target = static_cast<size_t>(queries[query].second);
+                if (!engine.reached(slot, target)) {
+                    return;
+                }
+                std::vector<int>& path = paths[query].vertices;
+                for (size_t v = target;; v = static_cast<size_t>(engine.parent[slot * numVertices + v])) {
+                    path.push_back(static_cast<int>(v));
+                    if (engine.parent[slot * numVertices + v] == static_cast<int>(v)) {
+                        break;
+                    }
+                }
+                std::reverse(path.begin(), path.end());
+                paths[query].cost = static_cast<long long>(path.size()) - 1;
+            });
+            return paths;
+        }
 
-            // Explore adjacent vertices
-            for (size_t v = 0; v < graph.adj(u).size(); ++v) {
-                if (graph.adj(u)[v] != 0 && !visited[v]) {
-                    visited[v] = true; // Mark vertex as visited
-                    parent[v] = u; // Set parent of vertex v to u
-                    q.push(static_cast<int>(v)); // Enqueue vertex v
+        // Weighted graphs: independent queries, one per-thread engine each
+        for (const auto& [src, dest] : queries) {
+            checkedVertex(src, graph.vertices());
+            checkedVertex(dest, graph.vertices());
+        }
+        parallelForDynamic(queries.size(), 1, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; ++i) {
+                size_t source = static_cast<size_t>(queries[i].first);
+                size_t target = static_cast<size_t>(queries[i].second);
+                if (weights == WeightKind::NonNegative) {
+                    threadBidirectional().dijkstra(DenseAdjacency(graph), source, target, paths[i]);
+                } else {
+                    bellmanFordPath(graph, source, target, paths[i]);
                 }
             }
+        });
+        return paths;
+    }
+
+    bool Algorithms::dijkstra(const Graph &graph, int src, int dest, Path &out, bool useRadixHeap) {
+        size_t numVertices = graph.vertices();
+        size_t source = checkedVertex(src, numVertices);
+        size_t target = checkedVertex(dest, numVertices);
+        DijkstraEngine& engine = threadDijkstra(useRadixHeap ? DijkstraEngine::HeapKind::Radix
+                                                             : DijkstraEngine::HeapKind::DAry);
+        if (!engine.run(DenseAdjacency(graph), source, target)) {
+            out.vertices.clear();
+            out.cost = 0;
+            throw std::invalid_argument("Dijkstra requires non-negative edge weights");
         }
+        return engine.pathTo(target, out);
+    }
 
-        // If destination is not reachable from source, return "-1"
-        if (!visited[static_cast<std::vector<bool>::size_type>(dest)]) {
-            return "-1"; // No path found
+    bool ShortestPathTree::pathTo(std::size_t to, Path &out) const {
+        if (to >= distance.size()) {
+            throw std::out_of_range("Vertex index out of range");
+        }
+        out.vertices.clear();
+        out.cost = 0;
+        if (distance[to] == UNREACHABLE) {
+            return false;
         }
+        for (std::size_t v = to; v != source; v = static_cast<std::size_t>(parent[v])) {
+            out.vertices.push_back(static_cast<int>(v));
+        }
+        out.vertices.push_back(static_cast<int>(source));
+        std::reverse(out.vertices.begin(), out.vertices.end());
+        out.cost = distance[to];
+        return true;
+    }
 
-        // Reconstruct the shortest path from destination to source
-        std::vector<int> path;
-        for (int v = dest; v != -1; v = parent[static_cast<std::vector<int>::size_type>(v)]) {
-            path.push_back(v); // Add vertex to path
+    bool DistanceMatrix::pathTo(std::size_t from, std::size_t to, Path &out) const {
+        if (next.empty()) {
+            throw std::logic_error("Distance matrix was computed without next hops");
+        }
+        if (from >= vertices || to >= vertices) {
+            throw std::out_of_range("Vertex index out of range");
         }
-        std::reverse(path.begin(), path.end()); // Reverse the path to get source to destination order
+        out.vertices.clear();
+        out.cost = 0;
+        if (at(from, to) == UNREACHABLE) {
+            return false;
+        }
+        out.vertices.push_back(static_cast<int>(from));
+        for (std::size_t v = from; v != to;) {
+            v = static_cast<std::size_t>(next[v * vertices + to]);
+            out.vertices.push_back(static_cast<int>(v));
+        }
+        out.cost = at(from, to);
+        return true;
+    }
+
+    std::span<const int> Path::span() const {
+        return std::span<const int>(vertices);
+    }
 
-        // Construct the path string
+    std::string Path::toString() const {
+        if (vertices.empty()) {
+            return "-1"; // No path found
+        }
         std::stringstream ss;
-        for (size_t i = 0; i < path.size(); i++) {
+        for (size_t i = 0; i < vertices.size(); i++) {
             if (i > 0) ss << "->"; // Add "->" separator between vertices
-            ss << path[i]; // Add vertex to string
+            ss << vertices[i]; // Add vertex to string
         }
         return ss.str(); // Return the shortest path string
     }
 
+    // Both entry points share one engine; only the adjacency view differs
+    BFSTree Algorithms::bfs(const Graph &graph, int src) {
+        BFSEngine engine;
+        engine.run(DenseAdjacency(graph), checkedVertex(src, graph.vertices()));
+        return BFSTree{std::move(engine.parent), std::move(engine.depth)};
+    }
 
-    /**
- This function checks whether the graph contains a negative weight cycle using the Bellman-Ford algorithm.
-     You initialize distances to vertices as INT_MAX and relax edges iteratively.
-     If any edge can still be relaxed after the maximum number of iterations,
-     it indicates the presence of a negative weight cycle.
- */
-    bool Algorithms::negativeCycle(Graph &graph) {
-        size_t numVertices = graph.vertices();
-        vector<int> distance(numVertices, INT_MAX); // Initialize distances to vertices as INT_MAX
-        distance[0] = 0; // Set distance to source vertex as 0
-
-        // Relax edges repeatedly
-        for (size_t i = 0; i < numVertices - 1; i++) {
-            for (const auto& edge : graph.edges()) {
-                int u, v, weight;
-                tie(u, v, weight) = edge; // Unpack edge tuple
-                // If relaxing the edge results in a shorter path, update the distance
-                if (distance[static_cast<std::size_t>(u)] != INT_MAX && distance[static_cast<std::size_t>(u)] + weight < distance[static_cast<std::size_t>(v)]) {
-                    distance[static_cast<std::size_t>(v)] = distance[static_cast<std::size_t>(u)] + weight;
-                }
-            }
+    BFSTree Algorithms::bfs(const SparseIndex &out, const SparseIndex &in, int src) {
+        if (out.vertices() != in.vertices()) {
+            throw std::invalid_argument("CSR and CSC indexes must cover the same vertices");
+        }
+        BFSEngine engine;
+        engine.run(SparseAdjacency(out, in), checkedVertex(src, out.vertices()));
+        return BFSTree{std::move(engine.parent), std::move(engine.depth)};
+    }
+
+    std::vector<long long> Algorithms::deltaStepping(const Graph &graph, int src, long long delta) {
+        return deltaStepping(graph.csr(), src, delta);
+    }
+
+    std::vector<long long> Algorithms::deltaStepping(const SparseIndex &out, int src, long long delta) {
+        thread_local DeltaStepping engine;
+        return engine.run(out, checkedVertex(src, out.vertices()), delta);
+    }
+
+    ShortestPathTree Algorithms::bellmanFord(const Graph &graph, int src) {
+        SparseIndex index = graph.csr();
+        size_t source = checkedVertex(src, index.vertices());
+        BellmanFord& engine = chooseBellmanFord(index);
+        if (!engine.run(index, source)) {
+            throw std::invalid_argument("Graph contains a negative cycle reachable from the source");
         }
+        return ShortestPathTree{source, engine.distance, engine.parent};
+    }
 
-        // Check for negative weight cycles
-        for (const auto& edge : graph.edges()) {
-            int u, v, weight;
-            tie(u, v, weight) = edge; // Unpack edge tuple
-            // If relaxing the edge further results in a shorter path, a negative weight cycle exists
-            if (distance[static_cast<std::size_t>(u)] != INT_MAX && distance[static_cast<std::size_t>(u)] + weight < distance[static_cast<std::size_t>(v)]) {
-                return true;
+    ShortestPathTree Algorithms::dagShortestPaths(const Graph &graph, int src) {
+        return dagPaths(graph, src, false);
+    }
+
+    ShortestPathTree Algorithms::dagLongestPaths(const Graph &graph, int src) {
+        return dagPaths(graph, src, true);
+    }
+
+// Every vertex starts a path of length 0, so the heaviest distance ends the critical path;
+// its parents lead back to a vertex that is its own parent, where the path starts.
+    Path Algorithms::criticalPath(const Graph &graph) {
+        SparseIndex out = graph.csr();
+        std::vector<long long> distance;
+        std::vector<int> parent;
+        TopologicalSort::paths(graph.csc(), checkedOrder(out), TopologicalSort::ALL_SOURCES, true, distance, parent);
+        Path path;
+        if (distance.empty()) {
+            return path;
+        }
+        size_t end = static_cast<size_t>(std::max_element(distance.begin(), distance.end()) - distance.begin());
+        for (size_t v = end;; v = static_cast<size_t>(parent[v])) {
+            path.vertices.push_back(static_cast<int>(v));
+            if (parent[v] == static_cast<int>(v)) {
+                break;
             }
         }
+        std::reverse(path.vertices.begin(), path.vertices.end());
+        path.cost = distance[end];
+        return path;
+    }
+
+    DistanceMatrix Algorithms::floydWarshall(const Graph &graph, bool withNextHop) {
+        return FloydWarshall::run(graph, withNextHop);
+    }
+
+    DistanceMatrix Algorithms::johnson(const Graph &graph) {
+        DistanceMatrix result;
+        result.vertices = graph.vertices();
+        result.distance.resize(result.vertices * result.vertices);
+        Johnson::run(graph.csr(), [&](std::size_t source, std::span<const long long> row) {
+            std::copy(row.begin(), row.end(), result.distance.begin() + static_cast<std::ptrdiff_t>(source * result.vertices));
+        });
+        return result;
+    }
+
+    void Algorithms::johnson(const Graph &graph, const std::function<void(std::size_t, std::span<const long long>)> &row) {
+        Johnson::run(graph.csr(), row);
+    }
 
-        return false; // No negative weight cycle found
+    bool Algorithms::negativeCycle(Graph &graph) {
+        return findNegativeCycle(graph).has_value();
     }
+
+    // Bellman-Ford from a virtual source joined to every vertex, so cycles in any component
+    // are found. Large graphs with several workers use parallel rounds; otherwise the queue
+    // strategy, whose subtree disassembly stops at the first cycle it closes.
+    std::optional<std::vector<int>> Algorithms::findNegativeCycle(const Graph &graph) {
+        SparseIndex index = graph.csr();
+        if (TopologicalSort::run(index).acyclic()) {
+            return std::nullopt; // No cycle at all, so no negative one
+        }
+        BellmanFord& engine = chooseBellmanFord(index);
+        if (engine.runFromAll(index)) {
+            return std::nullopt;
+        }
+        return engine.cycle;
+    }
+
+    std::optional<MeanCycle> Algorithms::minimumMeanCycle(const Graph &graph, bool useKarp) {
+        SparseIndex out = graph.csr();
+        return useKarp ? MinimumMeanCycle::karp(out) : MinimumMeanCycle::howard(out, graph.csc());
+    }
+
+    SpanningForest Algorithms::minimumSpanningForest(const Graph &graph, SpanningMethod method) {
+        const std::vector<std::vector<int>>& rows = graph.getGraph();
+        size_t n = rows.size();
+        bool symmetric = !graph.isDirected();
+        if (method == SpanningMethod::Automatic) {
+            // Off-diagonal entries, two per undirected edge when the matrix is symmetric (an
+            // estimate otherwise); counting is much cheaper than building the edge list
+            std::atomic<size_t> entries{0};
+            parallelFor(n, rowsPerChunk(n), [&](size_t begin, size_t end, size_t) {
+                size_t local = 0;
+                for (size_t u = begin; u < end; ++u) {
+                    local += n - static_cast<size_t>(std::count(rows[u].begin(), rows[u].end(), 0)) - (rows[u][u] != 0);
+                }
+                entries.fetch_add(local, std::memory_order_relaxed);
+            });
+            size_t pairs = entries.load() / 2;
+            if (pairs * 4 >= n * (n - 1) / 2 && n > 1) {
+                method = SpanningMethod::Prim;
+            } else if (workerCount() > 1 && pairs >= MinimumSpanningForest::PARALLEL_MIN_EDGES) {
+                method = SpanningMethod::Boruvka;
+            } else {
+                method = SpanningMethod::FilterKruskal;
+            }
+        }
+        switch (method) {
+            case SpanningMethod::Prim:
+                return MinimumSpanningForest::prim(rows, symmetric);
+            case SpanningMethod::Boruvka:
+                return MinimumSpanningForest::boruvka(n, MinimumSpanningForest::undirectedEdges(rows, symmetric));
+            default:
+                return MinimumSpanningForest::filterKruskal(n, MinimumSpanningForest::undirectedEdges(rows, symmetric));
+        }
+    }
+
     Algorithms::Algorithms() { }
 } // namespace ariel
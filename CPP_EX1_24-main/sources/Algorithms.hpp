@@ -1,7 +1,13 @@
 #pragma once
 
 #include "Graph.hpp"
+#include <climits>
+#include <functional>
+#include <optional>
+#include <span>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #ifndef CPP_EX4_ALGORITHMS_HPP
@@ -10,6 +16,203 @@
 namespace ariel {
     class Graph; // Forward declaration
 
+    /**
+     * @brief Breadth-first search tree from a single source.
+     */
+    struct BFSTree {
+        std::vector<int> parent; // -1 if unreachable; the source is its own parent
+        std::vector<int> depth;  // Number of edges from the source, -1 if unreachable
+    };
+
+    /**
+     * @brief Connected-component labeling of a graph.
+     */
+    struct Components {
+        std::vector<int> label;          // Component of each vertex, numbered by smallest member
+        std::vector<std::size_t> sizes;  // Number of vertices in each component
+
+        /**
+         * @brief Get the number of components.
+         *
+         * @return The number of components.
+         */
+        std::size_t count() const { return sizes.size(); }
+    };
+
+    /**
+     * @brief Strongly connected components and the acyclic graph they condense to.
+     */
+    struct Condensation {
+        Components components; // Numbered by smallest member, as in connected components
+        // Edge c -> d when an edge joins components c and d, with the lightest such weight
+        SparseIndex dag;
+    };
+
+    /**
+     * @brief A topological order of a directed graph, or a cycle proving there is none.
+     */
+    struct TopologicalOrder {
+        // Every vertex after all of its predecessors, level by level; empty on a cycle
+        std::vector<int> order;
+        // Most edges on any path into each vertex; empty on a cycle
+        std::vector<int> level;
+        // From its smallest vertex in edge order, the last leading back to the first; empty if acyclic
+        std::vector<int> cycle;
+
+        /**
+         * @brief Check whether the graph was ordered.
+         *
+         * @return True if the graph has no directed cycle.
+         */
+        bool acyclic() const { return cycle.empty(); }
+    };
+
+    /**
+     * @brief Algorithm choice for Algorithms::stronglyConnectedComponents().
+     */
+    enum class ComponentMethod {
+        Automatic,      // By size and worker count, see Algorithms::stronglyConnectedComponents()
+        Tarjan,         // Iterative, sequential
+        ForwardBackward // Parallel trimming, forward-backward and coloring
+    };
+
+    /**
+     * @brief A path between two vertices, with its total weight.
+     *
+     * Pass the same Path to repeated queries to reuse its buffer.
+     */
+    struct Path {
+        std::vector<int> vertices; // From source to destination; empty if there is no path
+        long long cost = 0;        // Sum of the edge weights along the path
+
+        /**
+         * @brief Check whether a path was found.
+         *
+         * @return True if the path is non-empty.
+         */
+        bool found() const { return !vertices.empty(); }
+
+        /**
+         * @brief Get a view of the path's vertices.
+         *
+         * @return The vertices from source to destination.
+         */
+        std::span<const int> span() const;
+
+        /**
+         * @brief Format the path as "0->1->2", or "-1" if there is no path.
+         *
+         * @return The formatted path.
+         */
+        std::string toString() const;
+    };
+
+    /**
+     * @brief A two-coloring of the vertices of a bipartite graph.
+     *
+     * Pass the same Bipartition to repeated queries to reuse its buffer.
+     */
+    struct Bipartition {
+        bool bipartite = false;
+        std::vector<int> color; // 0 or 1 per vertex; empty if the graph is not bipartite
+
+        /**
+         * @brief Format as "The graph is bipartite: A={...}, B={...}", or "0" if not bipartite.
+         *
+         * @return The formatted partition.
+         */
+        std::string toString() const;
+    };
+
+    /**
+     * @brief Single-source distances with the parent of every vertex on a lightest path.
+     */
+    struct ShortestPathTree {
+        static constexpr long long UNREACHABLE = LLONG_MAX;
+
+        std::size_t source = 0;
+        std::vector<long long> distance; // UNREACHABLE if not reached
+        std::vector<int> parent;         // -1 if not reached; the source is its own parent
+
+        /**
+         * @brief Follow the parents from a vertex back to the source.
+         *
+         * @param to The end vertex.
+         * @param out Receives the path and its cost; its buffer is reused.
+         * @return True if to is reachable.
+         * @throw std::out_of_range If to is not a vertex of the tree.
+         */
+        bool pathTo(std::size_t to, Path &out) const;
+    };
+
+    /**
+     * @brief All-pairs distances in row-major order, with optional next hops for paths.
+     */
+    struct DistanceMatrix {
+        static constexpr long long UNREACHABLE = LLONG_MAX;
+
+        std::size_t vertices = 0;
+        std::vector<long long> distance; // [from * vertices + to], UNREACHABLE if there is no path
+        std::vector<int> next;           // [from * vertices + to]: vertex after from on a lightest
+                                         // path, -1 if none; empty unless next hops were requested
+
+        /**
+         * @brief Get the distance between two vertices.
+         *
+         * @param from The start vertex.
+         * @param to The end vertex.
+         * @return The distance, UNREACHABLE if there is no path.
+         */
+        long long at(std::size_t from, std::size_t to) const { return distance[from * vertices + to]; }
+
+        /**
+         * @brief Follow the next hops from one vertex to another.
+         *
+         * @param from The start vertex.
+         * @param to The end vertex.
+         * @param out Receives the path and its cost; its buffer is reused.
+         * @return True if there is a path.
+         * @throw std::logic_error If the matrix was computed without next hops.
+         */
+        bool pathTo(std::size_t from, std::size_t to, Path &out) const;
+    };
+
+    /**
+     * @brief A cycle with its exact mean edge weight.
+     */
+    struct MeanCycle {
+        std::vector<int> vertices;  // In order; the edge from the last vertex back to the first closes it
+        long long weight = 0;       // Sum of the cycle's edge weights
+        long long numerator = 0;    // The mean weight / vertices.size() as a reduced fraction
+        long long denominator = 1;  // Always positive
+
+        /**
+         * @brief Get the mean as a floating-point number.
+         *
+         * @return numerator / denominator.
+         */
+        double mean() const { return static_cast<double>(numerator) / static_cast<double>(denominator); }
+    };
+
+    /**
+     * @brief A minimum spanning forest: one minimum spanning tree per connected component.
+     */
+    struct SpanningForest {
+        std::vector<std::tuple<int, int, int>> edges; // (u, v, weight) with u < v, sorted
+        long long weight = 0;                         // Sum of the edge weights
+        std::size_t components = 0;                   // Number of trees, isolated vertices included
+    };
+
+    /**
+     * @brief Algorithm choice for Algorithms::minimumSpanningForest().
+     */
+    enum class SpanningMethod {
+        Automatic,     // By density and size, see Algorithms::minimumSpanningForest()
+        Boruvka,       // Parallel rounds over a concurrent union-find
+        FilterKruskal, // Kruskal that filters out heavy edges before sorting them
+        Prim           // Indexed heap, reading the adjacency matrix directly
+    };
+
     /**
      * @brief Class containing various graph algorithms.
      */
@@ -18,19 +221,106 @@ namespace ariel {
         /**
          * @brief Check if the graph is connected.
          *
+         * Undirected graphs stop linking as soon as a single component remains; directed
+         * graphs must reach every vertex from vertex 0.
+         *
          * @param graph The graph to check.
          * @return True if the graph is connected, false otherwise.
          */
         static bool isConnected(Graph &graph);
 
+        /**
+         * @brief Answer a batch of reachability queries.
+         *
+         * Queries are grouped by source and answered by multi-source BFS, up to
+         * MultiSourceBFS::MAX_SOURCES traversals per pass over the graph.
+         *
+         * @param graph The graph to search in.
+         * @param queries (src, dest) pairs.
+         * @return For each query, whether dest is reachable from src.
+         * @throw std::out_of_range If a query names a vertex outside the graph.
+         */
+        static std::vector<bool> isConnected(const Graph &graph, const std::vector<std::pair<int, int>> &queries);
+
+        /**
+         * @brief Label the connected components of the graph.
+         *
+         * Edges join their endpoints regardless of direction, so for directed graphs these
+         * are the weakly connected components. Runs Afforest over a concurrent union-find.
+         *
+         * @param graph The graph to label.
+         * @return The component of every vertex and the size of every component.
+         */
+        static Components connectedComponents(const Graph &graph);
+
+        /**
+         * @brief Label the strongly connected components and build their condensation.
+         *
+         * Automatic runs forward-backward from StronglyConnectedComponents::PARALLEL_MIN_EDGES
+         * edges when more than one worker is available, and Tarjan otherwise. Both give the
+         * same result. On an undirected graph the components are the connected components.
+         *
+         * @param graph The graph to label.
+         * @param method The algorithm to use.
+         * @return The component of every vertex, the size of every component and the
+         *         condensation DAG.
+         */
+        static Condensation stronglyConnectedComponents(const Graph &graph, ComponentMethod method = ComponentMethod::Automatic);
+
+        /**
+         * @brief Order the vertices so that every edge points forward (Kahn's algorithm).
+         *
+         * Each round releases one level in parallel; levels are sorted, so the order is the
+         * same for every worker count. Undirected edges count in both directions.
+         *
+         * @param graph The graph to order.
+         * @return The order and levels, or a directed cycle if there is none.
+         */
+        static TopologicalOrder topologicalSort(const Graph &graph);
+
         /**
          * @brief Check if the graph contains a cycle.
          *
+         * Directed graphs look for a directed cycle; undirected graphs for a cycle that
+         * does not reuse an edge (see findCycle()).
+         *
          * @param graph The graph to check.
          * @return True if the graph contains a cycle, false otherwise.
          */
         static bool isContainsCycle(Graph &graph);
 
+        /**
+         * @brief Find a cycle in the graph, using the engine that matches Graph::isDirected().
+         *
+         * @param graph The graph to search.
+         * @return The cycle's vertices in order (the edge from the last vertex back to the
+         *         first closes it), or std::nullopt if the graph has no cycle.
+         */
+        static std::optional<std::vector<int>> findCycle(const Graph &graph);
+
+        /**
+         * @brief Find a cycle treating every edge as undirected.
+         *
+         * Union-find over the edges; stops at the first edge that closes a cycle, so at most
+         * V unions are attempted. An edge and its reverse are one edge, so two vertices
+         * joined by a single edge are not a cycle; a self loop is.
+         *
+         * @param graph The graph to search.
+         * @return The cycle's vertices in order, or std::nullopt if the graph is a forest.
+         */
+        static std::optional<std::vector<int>> findUndirectedCycle(const Graph &graph);
+
+        /**
+         * @brief Find a directed cycle.
+         *
+         * Iterative three-color DFS, so long paths cannot overflow the call stack. A pair
+         * of opposite edges u->v, v->u is a cycle of length two.
+         *
+         * @param graph The graph to search.
+         * @return The cycle's vertices in order, or std::nullopt if the graph is a DAG.
+         */
+        static std::optional<std::vector<int>> findDirectedCycle(const Graph &graph);
+
         /**
          * @brief Check if the graph is bipartite and return its partition sets.
          *
@@ -39,16 +329,185 @@ namespace ariel {
          */
         static std::string isBipartite(Graph &graph);
 
+        /**
+         * @brief Two-color the graph if it is bipartite.
+         *
+         * @param graph The graph to check.
+         * @param out Receives the coloring; its buffer is reused.
+         * @return True if the graph is bipartite.
+         */
+        static bool bipartition(const Graph &graph, Bipartition &out);
+
         /**
          * @brief Find the shortest path between two vertices in the graph.
          *
          * @param graph The graph to search in.
          * @param src The source vertex.
          * @param dest The destination vertex.
-         * @return A string representing the shortest path from src to dest, or "-1" if no path exists.
+         * @return A string representing the lightest path from src to dest, or "-1" if no path exists.
          */
         static std::string shortestPath(Graph &graph, int src, int dest);
 
+        /**
+         * @brief Find the lightest path between two vertices into a caller-owned buffer.
+         *
+         * Uses bidirectional BFS when every edge weighs 1, bidirectional Dijkstra when all
+         * weights are non-negative and Bellman-Ford otherwise.
+         *
+         * @param graph The graph to search in.
+         * @param src The source vertex.
+         * @param dest The destination vertex.
+         * @param out Receives the path and its cost; its buffer is reused.
+         * @return True if a lightest path exists: dest is reachable and no negative cycle
+         *         is reachable from src.
+         * @throw std::out_of_range If src or dest is not a vertex of the graph.
+         */
+        static bool shortestPath(const Graph &graph, int src, int dest, Path &out);
+
+        /**
+         * @brief Find the lightest path for a batch of (src, dest) queries.
+         *
+         * Unit-weight graphs are answered by multi-source BFS, so queries sharing the graph
+         * also share the passes over it; other graphs run the single-query engines for the
+         * queries in parallel.
+         *
+         * @param graph The graph to search in.
+         * @param queries (src, dest) pairs.
+         * @return For each query, the path and its cost; empty if there is none.
+         * @throw std::out_of_range If a query names a vertex outside the graph.
+         */
+        static std::vector<Path> shortestPath(const Graph &graph, const std::vector<std::pair<int, int>> &queries);
+
+        /**
+         * @brief Find the lightest path with Dijkstra's algorithm.
+         *
+         * The search stops as soon as dest is settled and reuses a per-thread workspace.
+         *
+         * @param graph The graph to search in; weights must be non-negative.
+         * @param src The source vertex.
+         * @param dest The destination vertex.
+         * @param out Receives the path and its cost; its buffer is reused.
+         * @param useRadixHeap Use a radix heap (default) instead of a 4-ary heap.
+         * @return True if dest is reachable from src.
+         * @throw std::out_of_range If src or dest is not a vertex of the graph.
+         * @throw std::invalid_argument If the search reaches a negative edge.
+         */
+        static bool dijkstra(const Graph &graph, int src, int dest, Path &out, bool useRadixHeap = true);
+
+        /**
+         * @brief Compute single-source distances with parallel delta-stepping.
+         *
+         * @param graph The graph to search in; weights must be non-negative.
+         * @param src The source vertex.
+         * @param delta The bucket width, or 0 to derive it from the weight distribution.
+         * @return The distance to every vertex, LLONG_MAX if it is not reachable.
+         * @throw std::out_of_range If src is not a vertex of the graph.
+         * @throw std::invalid_argument If the graph has a negative edge.
+         */
+        static std::vector<long long> deltaStepping(const Graph &graph, int src, long long delta = 0);
+
+        /**
+         * @brief Compute single-source distances with parallel delta-stepping over a CSR index.
+         *
+         * @param out The CSR index of the graph (see Graph::csr()); weights must be non-negative.
+         * @param src The source vertex.
+         * @param delta The bucket width, or 0 to derive it from the weight distribution.
+         * @return The distance to every vertex, LLONG_MAX if it is not reachable.
+         * @throw std::out_of_range If src is not a vertex of the graph.
+         * @throw std::invalid_argument If the index has a negative weight.
+         */
+        static std::vector<long long> deltaStepping(const SparseIndex &out, int src, long long delta = 0);
+
+        /**
+         * @brief Compute single-source distances with Bellman-Ford; negative edges are allowed.
+         *
+         * Graphs with at least BellmanFord::PARALLEL_MIN_EDGES edges relax each round's
+         * changed vertices in parallel when more than one worker is configured; the parents
+         * are the same for every worker count (the smallest predecessor wins ties). Smaller
+         * graphs run the sequential queue-based engine.
+         *
+         * @param graph The graph to search in.
+         * @param src The source vertex.
+         * @return The distances and parents from src.
+         * @throw std::out_of_range If src is not a vertex of the graph.
+         * @throw std::invalid_argument If a negative cycle is reachable from src.
+         */
+        static ShortestPathTree bellmanFord(const Graph &graph, int src);
+
+        /**
+         * @brief Compute single-source shortest paths on a directed acyclic graph in O(V + E).
+         *
+         * Distances are relaxed in topological order, so negative weights are allowed. Ties
+         * pick the smallest predecessor.
+         *
+         * @param graph The graph to search in.
+         * @param src The source vertex.
+         * @return The distances and parents from src.
+         * @throw std::out_of_range If src is not a vertex of the graph.
+         * @throw std::invalid_argument If the graph has a directed cycle.
+         */
+        static ShortestPathTree dagShortestPaths(const Graph &graph, int src);
+
+        /**
+         * @brief Compute single-source longest paths on a directed acyclic graph in O(V + E).
+         *
+         * @param graph The graph to search in.
+         * @param src The source vertex.
+         * @return The longest distances and their parents from src.
+         * @throw std::out_of_range If src is not a vertex of the graph.
+         * @throw std::invalid_argument If the graph has a directed cycle.
+         */
+        static ShortestPathTree dagLongestPaths(const Graph &graph, int src);
+
+        /**
+         * @brief Find the heaviest path anywhere in a directed acyclic graph.
+         *
+         * This is the critical path of a job graph whose edge weights are durations. Ties
+         * pick the path ending at the smallest vertex.
+         *
+         * @param graph The graph to search in.
+         * @return The path; a single vertex of cost 0 if no edge is heavier than that, and
+         *         empty if the graph has no vertices.
+         * @throw std::invalid_argument If the graph has a directed cycle.
+         */
+        static Path criticalPath(const Graph &graph);
+
+        /**
+         * @brief Compute all-pairs distances with blocked Floyd-Warshall.
+         *
+         * @param graph The graph; negative edges are allowed.
+         * @param withNextHop Also record next hops so paths can be recovered.
+         * @return The distance matrix.
+         * @throw std::invalid_argument If the graph contains a negative cycle.
+         */
+        static DistanceMatrix floydWarshall(const Graph &graph, bool withNextHop = false);
+
+        /**
+         * @brief Compute all-pairs distances with Johnson's algorithm.
+         *
+         * Cheaper than floydWarshall() on sparse graphs: one Bellman-Ford for potentials,
+         * then one Dijkstra per source (in parallel) over the reweighted edges.
+         *
+         * @param graph The graph; negative edges are allowed.
+         * @return The distance matrix, without next hops.
+         * @throw std::invalid_argument If the graph contains a negative cycle.
+         */
+        static DistanceMatrix johnson(const Graph &graph);
+
+        /**
+         * @brief Compute all-pairs distances with Johnson's algorithm, one row at a time.
+         *
+         * Only a few rows per worker are held at once, so the V x V matrix never has to fit
+         * in memory.
+         *
+         * @param graph The graph; negative edges are allowed.
+         * @param row Called on the calling thread for every source in increasing order with
+         *            its distances (DistanceMatrix::UNREACHABLE where there is no path); the
+         *            span is only valid during the call.
+         * @throw std::invalid_argument If the graph contains a negative cycle (before any row).
+         */
+        static void johnson(const Graph &graph, const std::function<void(std::size_t, std::span<const long long>)> &row);
+
         /**
          * @brief Check if the graph contains a negative weight cycle.
          *
@@ -57,6 +516,72 @@ namespace ariel {
          */
         static bool negativeCycle(Graph &graph);
 
+        /**
+         * @brief Find a negative weight cycle anywhere in the graph.
+         *
+         * A topological sort answers acyclic graphs in O(V + E). Otherwise Bellman-Ford runs
+         * from a virtual source joined to every vertex, with 64-bit distances. The cycle comes
+         * from the shortest-path tree (or the parent pointers) as soon as relaxation closes
+         * one. Graphs with at least BellmanFord::PARALLEL_MIN_EDGES edges run their passes in
+         * parallel when more than one worker is configured.
+         *
+         * @param graph The graph to search.
+         * @return The cycle's vertices in order (the edge from the last vertex back to the
+         *         first closes it), or std::nullopt if there is no negative cycle.
+         */
+        static std::optional<std::vector<int>> findNegativeCycle(const Graph &graph);
+
+        /**
+         * @brief Find a cycle of minimum mean edge weight.
+         *
+         * Edges follow the matrix direction, so an undirected edge is a cycle of length two.
+         * Howard's policy iteration is the default: it is exact (integer arithmetic) and
+         * usually converges in a handful of iterations. Karp's algorithm always takes
+         * O(V * E) time and O(V^2) memory.
+         *
+         * @param graph The graph to search.
+         * @param useKarp Use Karp's algorithm instead of Howard's.
+         * @return The cycle and its mean, or std::nullopt if the graph has no cycle.
+         */
+        static std::optional<MeanCycle> minimumMeanCycle(const Graph &graph, bool useKarp = false);
+
+        /**
+         * @brief Compute a minimum spanning forest.
+         *
+         * Edges are undirected: u and v are joined if either matrix entry is non-zero, by the
+         * lighter of the two. Automatic picks Prim for dense matrices (at least a quarter of
+         * the vertex pairs joined), parallel Boruvka for graphs with at least
+         * MinimumSpanningForest::PARALLEL_MIN_EDGES edges when more than one worker is
+         * configured, and filter-Kruskal otherwise. Every method returns the same total weight.
+         *
+         * @param graph The graph; negative weights are allowed.
+         * @param method The algorithm to use.
+         * @return The forest's edges, total weight and number of trees.
+         */
+        static SpanningForest minimumSpanningForest(const Graph &graph, SpanningMethod method = SpanningMethod::Automatic);
+
+        /**
+         * @brief Run a direction-optimizing BFS over the dense adjacency matrix.
+         *
+         * @param graph The graph to traverse (edges follow the matrix direction).
+         * @param src The source vertex.
+         * @return The BFS tree from src.
+         * @throw std::out_of_range If src is not a vertex of the graph.
+         */
+        static BFSTree bfs(const Graph &graph, int src);
+
+        /**
+         * @brief Run a direction-optimizing BFS over sparse out- and in-neighbor indexes.
+         *
+         * @param out The CSR index of the graph (see Graph::csr()).
+         * @param in The CSC index of the same graph (see Graph::csc()).
+         * @param src The source vertex.
+         * @return The BFS tree from src.
+         * @throw std::out_of_range If src is not a vertex of the graph.
+         * @throw std::invalid_argument If the two indexes cover different vertex counts.
+         */
+        static BFSTree bfs(const SparseIndex &out, const SparseIndex &in, int src);
+
         /**
          * @brief Default constructor.
          */
@@ -0,0 +1,354 @@
+#pragma once
+
+#include "Graph.hpp"
+#include "Parallel.hpp"
+#include "SparseIndex.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#ifndef CPP_EX4_BFSENGINE_HPP
+#define CPP_EX4_BFSENGINE_HPP
+
+namespace ariel {
+    /**
+     * @brief Traversal view over the dense adjacency matrix of a Graph.
+     *
+     * Reads the matrix rows directly, without the per-call bounds check of Graph::adj().
+     */
+    class DenseAdjacency {
+    public:
+        explicit DenseAdjacency(const Graph& graph) : rows(graph.getGraph()) {}
+
+        std::size_t vertices() const { return rows.size(); }
+
+        // Expanding a vertex top-down always scans its whole row
+        std::size_t scanCost(std::size_t) const { return rows.size(); }
+
+        // Calls visit(v, weight) for every edge u->v
+        template <typename Visit>
+        void forEachOut(std::size_t u, const Visit& visit) const {
+            const std::vector<int>& row = rows[u];
+            for (std::size_t v = 0; v < row.size(); ++v) {
+                if (row[v] != 0) {
+                    visit(v, row[v]);
+                }
+            }
+        }
+
+        // Calls visit(u, weight) for every edge u->v (a column scan)
+        template <typename Visit>
+        void forEachIn(std::size_t v, const Visit& visit) const {
+            for (std::size_t u = 0; u < rows.size(); ++u) {
+                if (rows[u][v] != 0) {
+                    visit(u, rows[u][v]);
+                }
+            }
+        }
+
+        // First frontier vertex u (in index order) with an edge u->v, or -1.
+        // Walks the set bits of the frontier, so the cost is bounded by the frontier size.
+        int firstParentIn(std::size_t v, const std::vector<std::uint64_t>& frontier) const {
+            for (std::size_t word = 0; word < frontier.size(); ++word) {
+                std::uint64_t bits = frontier[word];
+                while (bits != 0) {
+                    std::size_t u = word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+                    if (rows[u][v] != 0) {
+                        return static_cast<int>(u);
+                    }
+                    bits &= bits - 1;
+                }
+            }
+            return -1;
+        }
+
+    private:
+        const std::vector<std::vector<int>>& rows;
+    };
+
+    /**
+     * @brief Traversal view over a CSR (out-neighbors) and CSC (in-neighbors) index pair.
+     */
+    class SparseAdjacency {
+    public:
+        SparseAdjacency(const SparseIndex& out, const SparseIndex& in) : out(out), in(in) {}
+
+        std::size_t vertices() const { return out.vertices(); }
+
+        std::size_t scanCost(std::size_t u) const { return out.degree(u); }
+
+        template <typename Visit>
+        void forEachOut(std::size_t u, const Visit& visit) const {
+            for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                visit(static_cast<std::size_t>(out.indices[e]), out.weights[e]);
+            }
+        }
+
+        template <typename Visit>
+        void forEachIn(std::size_t v, const Visit& visit) const {
+            for (std::size_t e = in.offsets[v]; e < in.offsets[v + 1]; ++e) {
+                visit(static_cast<std::size_t>(in.indices[e]), in.weights[e]);
+            }
+        }
+
+        int firstParentIn(std::size_t v, const std::vector<std::uint64_t>& frontier) const {
+            for (std::size_t e = in.offsets[v]; e < in.offsets[v + 1]; ++e) {
+                std::size_t u = static_cast<std::size_t>(in.indices[e]);
+                if ((frontier[u / 64] >> (u % 64)) & 1U) {
+                    return static_cast<int>(u);
+                }
+            }
+            return -1;
+        }
+
+    private:
+        const SparseIndex& out;
+        const SparseIndex& in;
+    };
+
+    /**
+     * @brief Direction-optimizing (Beamer) BFS shared by the traversal algorithms.
+     *
+     * Expands small frontiers top-down from a vertex queue and large frontiers bottom-up,
+     * where every unvisited vertex looks for a parent in a bitmap of the frontier and stops
+     * at the first hit. Levels whose scan cost reaches PARALLEL_LEVEL_COST are expanded by
+     * all workers (level-synchronous); smaller levels stay on the calling thread. The buffers
+     * are kept between runs, so reusing an engine does not allocate once it has seen a graph
+     * of the same size.
+     */
+    class BFSEngine {
+    public:
+        static constexpr std::size_t NO_TARGET = static_cast<std::size_t>(-1);
+
+        // Scan cost (matrix cells or CSR entries) from which a level is split across workers
+        static constexpr std::size_t PARALLEL_LEVEL_COST = std::size_t{1} << 16;
+
+        std::vector<int> parent; // -1 if unreached; the source is its own parent
+        std::vector<int> depth;  // -1 if unreached
+
+        /**
+         * @brief Run a BFS from source, stopping early once target is reached.
+         *
+         * Depths are deterministic; with several workers the parent chosen among equally
+         * deep candidates may vary between runs.
+         *
+         * @return The number of vertices reached (including the source).
+         */
+        template <typename Adjacency>
+        std::size_t run(const Adjacency& adjacency, std::size_t source, std::size_t target = NO_TARGET) {
+            std::size_t n = adjacency.vertices();
+            parent.assign(n, -1);
+            depth.assign(n, -1);
+            parent[source] = static_cast<int>(source);
+            depth[source] = 0;
+            std::size_t reached = 1;
+            if (source == target) {
+                return reached;
+            }
+
+            std::size_t unexploredCost = 0;
+            for (std::size_t v = 0; v < n; ++v) {
+                unexploredCost += adjacency.scanCost(v);
+            }
+            unexploredCost -= adjacency.scanCost(source);
+            Level frontier{1, adjacency.scanCost(source), false};
+            queue.assign(1, source);
+            bool bottomUp = false;
+            bool growing = true;
+            bool parallel = workerCount() > 1;
+
+            for (int level = 1; frontier.size > 0; ++level) {
+                if (!bottomUp && growing && frontier.cost > unexploredCost / TOP_DOWN_ALPHA) {
+                    queueToBits(n);
+                    bottomUp = true;
+                } else if (bottomUp && !growing && frontier.size < n / BOTTOM_UP_BETA) {
+                    bitsToQueue(n);
+                    bottomUp = false;
+                }
+
+                bool wide = parallel && (bottomUp ? unexploredCost : frontier.cost) >= PARALLEL_LEVEL_COST;
+                Level next;
+                if (bottomUp) {
+                    nextBits.assign(bits.size(), 0);
+                    next = wide ? bottomUpParallel(adjacency, level, target) : bottomUpStep(adjacency, 0, n, level, target);
+                    bits.swap(nextBits);
+                } else {
+                    next = wide ? topDownParallel(adjacency, level, target) : topDownStep(adjacency, level, target);
+                    queue.swap(nextQueue);
+                }
+
+                reached += next.size;
+                if (next.found) {
+                    break;
+                }
+                growing = next.size > frontier.size;
+                unexploredCost -= next.cost;
+                frontier = next;
+            }
+            return reached;
+        }
+
+    private:
+        // Beamer et al.'s tuned constants: go bottom-up once the frontier's edges exceed
+        // 1/14 of the unexplored edges, come back when it holds fewer than n/24 vertices.
+        static constexpr std::size_t TOP_DOWN_ALPHA = 14;
+        static constexpr std::size_t BOTTOM_UP_BETA = 24;
+        // Frontier vertices claimed at a time in a parallel top-down level
+        static constexpr std::size_t TOP_DOWN_CHUNK = 64;
+        // Vertices claimed at a time in a parallel bottom-up level; a multiple of 64 so
+        // every bitmap word is written by exactly one worker
+        static constexpr std::size_t BOTTOM_UP_CHUNK = 64 * 16;
+
+        struct Level {
+            std::size_t size = 0;
+            std::size_t cost = 0;
+            bool found = false;
+        };
+
+        std::vector<std::size_t> queue;
+        std::vector<std::size_t> nextQueue;
+        std::vector<std::uint64_t> bits;
+        std::vector<std::uint64_t> nextBits;
+        std::vector<std::vector<std::size_t>> localQueues;
+        std::vector<Level> localLevels;
+
+        template <typename Adjacency>
+        Level topDownStep(const Adjacency& adjacency, int level, std::size_t target) {
+            Level next;
+            nextQueue.clear();
+            for (std::size_t i = 0; i < queue.size() && !next.found; ++i) {
+                std::size_t u = queue[i];
+                adjacency.forEachOut(u, [&](std::size_t v, int) {
+                    if (parent[v] == -1) {
+                        parent[v] = static_cast<int>(u);
+                        depth[v] = level;
+                        nextQueue.push_back(v);
+                        next.cost += adjacency.scanCost(v);
+                        next.found = next.found || v == target;
+                    }
+                });
+            }
+            next.size = nextQueue.size();
+            return next;
+        }
+
+        // Workers claim chunks of the frontier and race to adopt each newly seen vertex
+        // with a CAS on its parent slot; winners append it to their own local queue.
+        template <typename Adjacency>
+        Level topDownParallel(const Adjacency& adjacency, int level, std::size_t target) {
+            std::size_t workers = workerCount();
+            localQueues.resize(workers);
+            localLevels.assign(workers, Level{});
+            for (auto& local : localQueues) {
+                local.clear();
+            }
+            std::atomic<bool> found{false};
+            parallelForDynamic(queue.size(), TOP_DOWN_CHUNK, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+                std::vector<std::size_t>& local = localQueues[worker];
+                Level& stats = localLevels[worker];
+                for (std::size_t i = begin; i < end && !found.load(std::memory_order_relaxed); ++i) {
+                    std::size_t u = queue[i];
+                    adjacency.forEachOut(u, [&](std::size_t v, int) {
+                        std::atomic_ref<int> slot(parent[v]);
+                        int expected = -1;
+                        if (slot.load(std::memory_order_relaxed) == -1 &&
+                            slot.compare_exchange_strong(expected, static_cast<int>(u), std::memory_order_relaxed)) {
+                            depth[v] = level;
+                            local.push_back(v);
+                            stats.cost += adjacency.scanCost(v);
+                            if (v == target) {
+                                found.store(true, std::memory_order_relaxed);
+                            }
+                        }
+                    });
+                }
+            });
+            nextQueue.clear();
+            Level next;
+            for (std::size_t worker = 0; worker < workers; ++worker) {
+                nextQueue.insert(nextQueue.end(), localQueues[worker].begin(), localQueues[worker].end());
+                next.cost += localLevels[worker].cost;
+            }
+            next.size = nextQueue.size();
+            next.found = found.load();
+            return next;
+        }
+
+        // Bottom-up over vertices [begin, end); only writes state owned by those vertices.
+        // The caller clears nextBits first.
+        template <typename Adjacency>
+        Level bottomUpStep(const Adjacency& adjacency, std::size_t begin, std::size_t end, int level,
+                           std::size_t target) {
+            Level next;
+            for (std::size_t v = begin; v < end && !next.found; ++v) {
+                if (parent[v] != -1) {
+                    continue;
+                }
+                int p = adjacency.firstParentIn(v, bits);
+                if (p >= 0) {
+                    parent[v] = p;
+                    depth[v] = level;
+                    nextBits[v / 64] |= std::uint64_t{1} << (v % 64);
+                    ++next.size;
+                    next.cost += adjacency.scanCost(v);
+                    next.found = v == target;
+                }
+            }
+            return next;
+        }
+
+        // Each vertex only looks for its own parent, so workers never write the same slot
+        template <typename Adjacency>
+        Level bottomUpParallel(const Adjacency& adjacency, int level, std::size_t target) {
+            std::size_t n = parent.size();
+            std::size_t workers = workerCount();
+            localLevels.assign(workers, Level{});
+            std::atomic<bool> found{false};
+            parallelForDynamic(n, BOTTOM_UP_CHUNK, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+                if (found.load(std::memory_order_relaxed)) {
+                    return;
+                }
+                Level chunk = bottomUpStep(adjacency, begin, end, level, target);
+                Level& stats = localLevels[worker];
+                stats.size += chunk.size;
+                stats.cost += chunk.cost;
+                if (chunk.found) {
+                    found.store(true, std::memory_order_relaxed);
+                }
+            });
+            Level next;
+            for (const Level& stats : localLevels) {
+                next.size += stats.size;
+                next.cost += stats.cost;
+            }
+            next.found = found.load();
+            return next;
+        }
+
+        void queueToBits(std::size_t n) {
+            bits.assign((n + 63) / 64, 0);
+            for (std::size_t u : queue) {
+                bits[u / 64] |= std::uint64_t{1} << (u % 64);
+            }
+        }
+
+        void bitsToQueue(std::size_t n) {
+            queue.clear();
+            for (std::size_t word = 0; word < bits.size(); ++word) {
+                std::uint64_t w = bits[word];
+                while (w != 0) {
+                    std::size_t u = word * 64 + static_cast<std::size_t>(std::countr_zero(w));
+                    if (u < n) {
+                        queue.push_back(u);
+                    }
+                    w &= w - 1;
+                }
+            }
+        }
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_BFSENGINE_HPP
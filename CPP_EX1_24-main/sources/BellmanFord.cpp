@@ -0,0 +1,320 @@
+#include "BellmanFord.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace ariel {
+
+    namespace {
+        // Frontier vertices claimed at a time by one worker in a parallel round
+        constexpr std::size_t FRONTIER_CHUNK = 64;
+        // Improved vertices committed per worker chunk
+        constexpr std::size_t COMMIT_GRAIN = 1 << 12;
+        // candidate[v] before any predecessor offered v's new distance
+        constexpr int NO_CANDIDATE = INT_MAX;
+    } // namespace
+
+    bool BellmanFord::run(const SparseIndex& out, std::size_t source) {
+        std::size_t n = out.vertices();
+        distance.assign(n, UNREACHABLE);
+        parent.assign(n, -1);
+        distance[source] = 0;
+        parent[source] = static_cast<int>(source);
+
+        before.assign(n + 1, -1);
+        after.assign(n + 1, -1);
+        depth.assign(n + 1, 0);
+        inTree.assign(n + 1, 0);
+        inTree[source] = 1;
+        frontier.assign(1, source);
+        return solve(out);
+    }
+
+    // Relaxing the virtual source's zero edges gives every vertex distance 0 with itself as
+    // parent. In the tree they hang below entry n in vertex order.
+    bool BellmanFord::runFromAll(const SparseIndex& out) {
+        std::size_t n = out.vertices();
+        distance.assign(n, 0);
+        parent.resize(n);
+        frontier.resize(n);
+        before.resize(n + 1);
+        after.resize(n + 1);
+        depth.assign(n + 1, 1);
+        inTree.assign(n + 1, 1);
+        for (std::size_t v = 0; v < n; ++v) {
+            parent[v] = static_cast<int>(v);
+            frontier[v] = v;
+            before[v] = v == 0 ? static_cast<int>(n) : static_cast<int>(v - 1);
+            after[v] = v + 1 == n ? -1 : static_cast<int>(v + 1);
+        }
+        before[n] = -1;
+        after[n] = n == 0 ? -1 : 0;
+        depth[n] = 0;
+        return solve(out);
+    }
+
+    bool BellmanFord::solve(const SparseIndex& out) {
+        cycle.clear();
+        passes = 0;
+        switch (strategy) {
+            case Strategy::Passes:
+                return runPasses(out);
+            case Strategy::Parallel:
+                return runParallel(out);
+            default:
+                return runQueue(out);
+        }
+    }
+
+    bool BellmanFord::runPasses(const SparseIndex& out) {
+        std::size_t n = out.vertices();
+        bool changed = true;
+        while (changed) {
+            if (passes == n) {
+                // Lightest paths have at most n - 1 edges, so pass n must have been quiet
+                parentCycle();
+                return false;
+            }
+            changed = false;
+            ++passes;
+            for (std::size_t u = 0; u < n; ++u) {
+                if (distance[u] == UNREACHABLE) {
+                    continue;
+                }
+                for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                    std::size_t v = static_cast<std::size_t>(out.indices[e]);
+                    if (distance[u] + out.weights[e] < distance[v]) {
+                        if (v == u) {
+                            cycle.assign(1, static_cast<int>(u)); // Negative self loop
+                            return false;
+                        }
+                        distance[v] = distance[u] + out.weights[e];
+                        parent[v] = static_cast<int>(u);
+                        changed = true;
+                    }
+                }
+            }
+            if (changed && parentCycle()) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool BellmanFord::runQueue(const SparseIndex& out) {
+        std::size_t n = out.vertices();
+        queued.assign(n, 0);
+        while (!frontier.empty()) {
+            // Round k holds the vertices improved over k-edge paths; round n needs a cycle.
+            // Subtree disassembly normally reports the cycle long before that.
+            if (++passes > n) {
+                return false;
+            }
+            next.clear();
+            for (std::size_t u : frontier) {
+                queued[u] = 0;
+                if (!inTree[u]) {
+                    continue; // An ancestor improved since u was queued; u will improve too
+                }
+                for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                    std::size_t v = static_cast<std::size_t>(out.indices[e]);
+                    long long through = distance[u] + out.weights[e];
+                    if (through >= distance[v]) {
+                        continue;
+                    }
+                    if (inTree[v] && detach(v, u)) {
+                        treeCycle(v, u);
+                        return false;
+                    }
+                    distance[v] = through;
+                    parent[v] = static_cast<int>(u);
+                    attach(v, u);
+                    if (!queued[v]) {
+                        queued[v] = 1;
+                        next.push_back(v);
+                    }
+                }
+            }
+            frontier.swap(next);
+        }
+        return true;
+    }
+
+    bool BellmanFord::runParallel(const SparseIndex& out) {
+        std::size_t n = out.vertices();
+        pending = distance;
+        candidate.assign(n, NO_CANDIDATE);
+        queued.assign(n, 0);
+        std::size_t sinceCheck = 0;
+        while (!frontier.empty()) {
+            if (passes == n) {
+                parentCycle(); // Round n needs a cycle, and Jacobi rounds leave it in the parents
+                return false;
+            }
+            ++passes;
+            localNext.resize(workerCount());
+            for (auto& local : localNext) {
+                local.clear();
+            }
+
+            // Lower pending[v] to the lightest offer of the round. distance is not written
+            // until the commit, so every offer is computed from the previous round.
+            std::atomic<std::size_t> selfLoop{n}; // Smallest vertex with a negative self loop
+            parallelForDynamic(frontier.size(), FRONTIER_CHUNK, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    std::size_t u = frontier[i];
+                    for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                        std::size_t v = static_cast<std::size_t>(out.indices[e]);
+                        long long offer = distance[u] + out.weights[e];
+                        if (offer >= distance[v]) {
+                            continue;
+                        }
+                        if (v == u) {
+                            std::size_t seen = selfLoop.load(std::memory_order_relaxed);
+                            while (v < seen && !selfLoop.compare_exchange_weak(seen, v, std::memory_order_relaxed)) {
+                            }
+                            continue;
+                        }
+                        std::atomic_ref<long long> slot(pending[v]);
+                        long long current = slot.load(std::memory_order_relaxed);
+                        while (offer < current && !slot.compare_exchange_weak(current, offer, std::memory_order_relaxed)) {
+                        }
+                        if (std::atomic_ref<char>(queued[v]).exchange(1, std::memory_order_relaxed) == 0) {
+                            localNext[worker].push_back(v);
+                        }
+                    }
+                }
+            });
+            if (selfLoop.load() != n) {
+                cycle.assign(1, static_cast<int>(selfLoop.load()));
+                return false;
+            }
+
+            // Among the frontier vertices whose offer won, keep the smallest as the parent
+            parallelForDynamic(frontier.size(), FRONTIER_CHUNK, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    std::size_t u = frontier[i];
+                    for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                        std::size_t v = static_cast<std::size_t>(out.indices[e]);
+                        if (v == u || pending[v] == distance[v] || distance[u] + out.weights[e] != pending[v]) {
+                            continue;
+                        }
+                        std::atomic_ref<int> slot(candidate[v]);
+                        int current = slot.load(std::memory_order_relaxed);
+                        int mine = static_cast<int>(u);
+                        while (mine < current && !slot.compare_exchange_weak(current, mine, std::memory_order_relaxed)) {
+                        }
+                    }
+                }
+            });
+
+            next.clear();
+            for (const auto& local : localNext) {
+                next.insert(next.end(), local.begin(), local.end());
+            }
+            parallelFor(next.size(), COMMIT_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    std::size_t v = next[i];
+                    distance[v] = pending[v];
+                    parent[v] = candidate[v];
+                    candidate[v] = NO_CANDIDATE;
+                    queued[v] = 0;
+                }
+            });
+            frontier.swap(next);
+
+            // Look for a parent cycle once the rounds since the last look touched n vertices,
+            // so the O(n) walk costs O(1) per relaxed vertex
+            sinceCheck += frontier.size();
+            if (sinceCheck >= n && !frontier.empty()) {
+                sinceCheck = 0;
+                if (parentCycle()) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Cut v and its subtree out of the tree. The subtree is the run of vertices after v in
+    // preorder that are deeper than v. Returns true if it holds improver, i.e. the new
+    // edge improver->v would close a negative cycle.
+    bool BellmanFord::detach(std::size_t v, std::size_t improver) {
+        if (v == improver) {
+            return true; // Negative self loop
+        }
+        int x = after[v];
+        while (x != -1 && depth[static_cast<std::size_t>(x)] > depth[v]) {
+            std::size_t descendant = static_cast<std::size_t>(x);
+            if (descendant == improver) {
+                return true;
+            }
+            inTree[descendant] = 0;
+            x = after[descendant];
+        }
+        // v is never a root here: a single source has everything else in its subtree, and
+        // under runFromAll() the virtual source precedes every vertex
+        int first = before[v];
+        after[static_cast<std::size_t>(first)] = x;
+        if (x != -1) {
+            before[static_cast<std::size_t>(x)] = first;
+        }
+        inTree[v] = 0;
+        return false;
+    }
+
+    // Insert v (with an empty subtree) as the first child of under
+    void BellmanFord::attach(std::size_t v, std::size_t under) {
+        int follower = after[under];
+        after[v] = follower;
+        before[v] = static_cast<int>(under);
+        if (follower != -1) {
+            before[static_cast<std::size_t>(follower)] = static_cast<int>(v);
+        }
+        after[under] = static_cast<int>(v);
+        depth[v] = depth[under] + 1;
+        inTree[v] = 1;
+    }
+
+    // improver lies below v in the tree: the tree path v -> ... -> improver plus the
+    // improving edge back to v
+    void BellmanFord::treeCycle(std::size_t v, std::size_t improver) {
+        for (std::size_t x = improver; x != v; x = static_cast<std::size_t>(parent[x])) {
+            cycle.push_back(static_cast<int>(x));
+        }
+        cycle.push_back(static_cast<int>(v));
+        std::reverse(cycle.begin(), cycle.end());
+    }
+
+    // Follow parent pointers from every vertex, each vertex walked once. A walk that runs
+    // into itself has found a cycle; walks stop at sources and at walked vertices.
+    bool BellmanFord::parentCycle() {
+        std::size_t n = parent.size();
+        walkState.assign(n, 0); // 0 unwalked, 1 on the current walk, 2 done
+        for (std::size_t start = 0; start < n; ++start) {
+            walk.clear();
+            std::size_t x = start;
+            while (walkState[x] == 0) {
+                walkState[x] = 1;
+                walk.push_back(x);
+                int up = parent[x];
+                if (up < 0 || static_cast<std::size_t>(up) == x) {
+                    break;
+                }
+                x = static_cast<std::size_t>(up);
+            }
+            if (walkState[x] == 1 && parent[x] >= 0 && static_cast<std::size_t>(parent[x]) != x) {
+                // The walk goes against the edges; reverse its loop into edge order
+                auto loop = std::find(walk.begin(), walk.end(), x);
+                for (auto it = walk.end(); it != loop;) {
+                    cycle.push_back(static_cast<int>(*--it));
+                }
+                return true;
+            }
+            for (std::size_t w : walk) {
+                walkState[w] = 2;
+            }
+        }
+        return false;
+    }
+} // namespace ariel
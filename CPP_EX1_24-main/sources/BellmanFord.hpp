@@ -0,0 +1,104 @@
+#pragma once
+
+#include "SparseIndex.hpp"
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+#ifndef CPP_EX4_BELLMANFORD_HPP
+#define CPP_EX4_BELLMANFORD_HPP
+
+namespace ariel {
+    /**
+     * @brief Reusable Bellman-Ford over a CSR index, with negative-cycle detection.
+     *
+     * Passes relaxes every edge of every reached vertex per pass and stops after the first
+     * pass that changes nothing.
+     *
+     * Queue (the default) only scans vertices whose distance changed, in FIFO order (SPFA),
+     * and keeps the shortest-path tree in preorder for Tarjan's subtree disassembly. When v
+     * improves, its subtree is cut out of the tree: those distances are stale, so their
+     * queue entries are skipped until they improve again. If the subtree contains the vertex
+     * that improved v, the tree would close a cycle of negative weight, which is reported at
+     * once instead of after V rounds.
+     *
+     * Parallel relaxes, like Queue, only the vertices whose distance changed in the
+     * previous round, with the round's frontier spread over the workers. Distances are
+     * lowered with a CAS atomic-min against the committed values of the previous round
+     * (Jacobi order), and a second scan of the frontier picks the smallest predecessor that
+     * achieves each new distance. The distances, parents and rounds are therefore the same
+     * whatever the worker count and scheduling.
+     *
+     * Passes and Parallel look for a cycle among the parent pointers (after every pass, or
+     * once the rounds since the last look have touched V vertices). Such a cycle always has
+     * negative weight, and one appears long before pass V.
+     */
+    class BellmanFord {
+    public:
+        enum class Strategy { Passes, Queue, Parallel };
+
+        static constexpr long long UNREACHABLE = LLONG_MAX;
+        // Edges from which Parallel beats Queue's sequential rounds despite doing more work
+        static constexpr std::size_t PARALLEL_MIN_EDGES = std::size_t{1} << 16;
+
+        std::vector<long long> distance; // UNREACHABLE if not reached
+        std::vector<int> parent;         // -1 if not reached; a source is its own parent until improved
+        std::vector<int> cycle;          // Negative cycle found by the last failed run, in edge order
+        std::size_t passes = 0;          // Passes (or FIFO rounds) made by the last run
+
+        explicit BellmanFord(Strategy strategy = Strategy::Queue) : strategy(strategy) {}
+
+        /**
+         * @brief Compute distances from source.
+         *
+         * @param out The CSR index of the graph; negative weights are allowed.
+         * @param source The source vertex; must be a vertex of the index.
+         * @return False if a negative cycle is reachable from source; cycle then holds it
+         *         and the distances are meaningless.
+         */
+        bool run(const SparseIndex& out, std::size_t source);
+
+        /**
+         * @brief Compute distances from a virtual source joined to every vertex by a zero edge.
+         *
+         * Every distance is at most 0, and any negative cycle in the graph is found.
+         *
+         * @param out The CSR index of the graph; negative weights are allowed.
+         * @return False if the graph has a negative cycle; cycle then holds one.
+         */
+        bool runFromAll(const SparseIndex& out);
+
+    private:
+        Strategy strategy;
+
+        // Queue and Parallel: the current and the next round of changed vertices
+        std::vector<std::size_t> frontier;
+        std::vector<std::size_t> next;
+        std::vector<char> queued;
+        // Shortest-path tree as a doubly linked list in preorder, -1 terminated. Entry n is
+        // the virtual source of runFromAll().
+        std::vector<int> before;
+        std::vector<int> after;
+        std::vector<std::size_t> depth;
+        std::vector<char> inTree;
+        // Parallel strategy: the round's atomic-min targets (equal to distance between
+        // rounds), the smallest predecessor reaching them, and per-worker next frontiers
+        std::vector<long long> pending;
+        std::vector<int> candidate;
+        std::vector<std::vector<std::size_t>> localNext;
+        // Parent-cycle search state
+        std::vector<char> walkState;
+        std::vector<std::size_t> walk;
+
+        bool solve(const SparseIndex& out);
+        bool runPasses(const SparseIndex& out);
+        bool runQueue(const SparseIndex& out);
+        bool runParallel(const SparseIndex& out);
+        bool detach(std::size_t v, std::size_t improver);
+        void attach(std::size_t v, std::size_t under);
+        void treeCycle(std::size_t v, std::size_t improver);
+        bool parentCycle();
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_BELLMANFORD_HPP
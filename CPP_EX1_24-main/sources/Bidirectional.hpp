@@ -0,0 +1,188 @@
+#pragma once
+
+#include "Algorithms.hpp"
+#include "BFSEngine.hpp"
+#include "Dijkstra.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+#ifndef CPP_EX4_BIDIRECTIONAL_HPP
+#define CPP_EX4_BIDIRECTIONAL_HPP
+
+namespace ariel {
+    /**
+     * @brief Reusable point-to-point search that grows one tree from the source along
+     * out-edges and one from the destination along in-edges until they meet.
+     *
+     * Each step expands the side with the smaller frontier, so on graphs that fan out the
+     * two searches together touch far fewer vertices than one search reaching dest.
+     * The adjacency must provide forEachIn (DenseAdjacency and SparseAdjacency do).
+     */
+    class BidirectionalSearch {
+    public:
+        static constexpr long long UNREACHABLE = LLONG_MAX;
+
+        std::size_t explored = 0; // Vertices expanded by the last query, both sides together
+
+        /**
+         * @brief Lightest path when every edge weighs 1.
+         *
+         * Whole levels are expanded at a time; the first level that touches the other tree
+         * holds the shortest meeting edge, and the search stops after it.
+         *
+         * @return False (with out cleared) if dest is not reachable from source.
+         */
+        template <typename Adjacency>
+        bool bfs(const Adjacency& adjacency, std::size_t source, std::size_t target, Path& out) {
+            if (start(adjacency.vertices(), source, target, out)) {
+                return true;
+            }
+            frontier[0].assign(1, source);
+            frontier[1].assign(1, target);
+            while (!frontier[0].empty() && !frontier[1].empty() && best == UNREACHABLE) {
+                std::size_t side = frontier[0].size() <= frontier[1].size() ? 0 : 1;
+                next.clear();
+                for (std::size_t u : frontier[side]) {
+                    ++explored;
+                    long long depth = distance[side][u] + 1;
+                    expand(adjacency, side, u, [&](std::size_t v, int) {
+                        if (distance[side][v] == UNREACHABLE) {
+                            distance[side][v] = depth;
+                            parent[side][v] = static_cast<int>(u);
+                            next.push_back(v);
+                        }
+                        meet(side, u, v, depth);
+                    });
+                }
+                frontier[side].swap(next);
+            }
+            return finish(out);
+        }
+
+        /**
+         * @brief Lightest path for non-negative weights.
+         *
+         * Settles vertices from the side whose heap is smaller and stops once the two
+         * smallest tentative distances add up to at least the best meeting found so far.
+         *
+         * @return False (with out cleared) if dest is not reachable from source.
+         */
+        template <typename Adjacency>
+        bool dijkstra(const Adjacency& adjacency, std::size_t source, std::size_t target, Path& out) {
+            if (start(adjacency.vertices(), source, target, out)) {
+                return true;
+            }
+            heap[0].reset(distance[0].size());
+            heap[1].reset(distance[1].size());
+            heap[0].pushOrDecrease(source, distance[0]);
+            heap[1].pushOrDecrease(target, distance[1]);
+            while (!heap[0].empty() && !heap[1].empty()) {
+                long long reach = distance[0][heap[0].top()] + distance[1][heap[1].top()];
+                if (best != UNREACHABLE && reach >= best) {
+                    break;
+                }
+                std::size_t side = heap[0].size() <= heap[1].size() ? 0 : 1;
+                std::size_t u = heap[side].pop(distance[side]);
+                ++explored;
+                long long base = distance[side][u];
+                expand(adjacency, side, u, [&](std::size_t v, int weight) {
+                    long long candidate = base + weight;
+                    if (candidate < distance[side][v]) {
+                        distance[side][v] = candidate;
+                        parent[side][v] = static_cast<int>(u);
+                        heap[side].pushOrDecrease(v, distance[side]);
+                    }
+                    meet(side, u, v, candidate);
+                });
+            }
+            return finish(out);
+        }
+
+    private:
+        // Index 0 is the forward search from the source, 1 the backward search from dest
+        std::vector<long long> distance[2];
+        std::vector<int> parent[2];
+        std::vector<std::size_t> frontier[2];
+        std::vector<std::size_t> next;
+        DAryHeap heap[2];
+        long long best = UNREACHABLE;
+        std::size_t meetSide = 0;
+        std::size_t meetFrom = 0;
+        std::size_t meetTo = 0;
+
+        // Reset the workspace; returns true (with out filled) when source == target
+        bool start(std::size_t n, std::size_t source, std::size_t target, Path& out) {
+            explored = 0;
+            best = UNREACHABLE;
+            for (std::size_t side = 0; side < 2; ++side) {
+                distance[side].assign(n, UNREACHABLE);
+                parent[side].assign(n, -1);
+            }
+            distance[0][source] = 0;
+            distance[1][target] = 0;
+            parent[0][source] = static_cast<int>(source);
+            parent[1][target] = static_cast<int>(target);
+            out.vertices.clear();
+            out.cost = 0;
+            if (source == target) {
+                out.vertices.push_back(static_cast<int>(source));
+                return true;
+            }
+            return false;
+        }
+
+        template <typename Adjacency, typename Visit>
+        static void expand(const Adjacency& adjacency, std::size_t side, std::size_t u, const Visit& visit) {
+            if (side == 0) {
+                adjacency.forEachOut(u, visit);
+            } else {
+                adjacency.forEachIn(u, visit);
+            }
+        }
+
+        // Edge u-v was scanned by one side with u at a final tree position and v reached at
+        // cost; if the other side has reached v, the two trees form a source-dest path.
+        void meet(std::size_t side, std::size_t u, std::size_t v, long long cost) {
+            long long other = distance[1 - side][v];
+            if (other != UNREACHABLE && cost + other < best) {
+                best = cost + other;
+                meetSide = side;
+                meetFrom = u;
+                meetTo = v;
+            }
+        }
+
+        // Join the tree path to meetFrom, the meeting edge and the other tree's path from meetTo.
+        // Tree paths only get lighter after the meeting is recorded, and best is optimal, so
+        // the joined path costs exactly best.
+        bool finish(Path& out) {
+            if (best == UNREACHABLE) {
+                return false;
+            }
+            std::vector<int>& path = out.vertices;
+            for (std::size_t v = meetFrom;; v = static_cast<std::size_t>(parent[meetSide][v])) {
+                path.push_back(static_cast<int>(v));
+                if (parent[meetSide][v] == static_cast<int>(v)) {
+                    break;
+                }
+            }
+            std::reverse(path.begin(), path.end());
+            std::size_t other = 1 - meetSide;
+            for (std::size_t v = meetTo;; v = static_cast<std::size_t>(parent[other][v])) {
+                path.push_back(static_cast<int>(v));
+                if (parent[other][v] == static_cast<int>(v)) {
+                    break;
+                }
+            }
+            if (meetSide == 1) {
+                std::reverse(path.begin(), path.end()); // Built from dest towards the source
+            }
+            out.cost = best;
+            return true;
+        }
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_BIDIRECTIONAL_HPP
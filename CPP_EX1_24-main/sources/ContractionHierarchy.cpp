@@ -0,0 +1,598 @@
+#include "ContractionHierarchy.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace ariel {
+
+    namespace {
+        // A witness search gives up after settling this many vertices. Giving up only adds a
+        // shortcut that was not strictly needed, so queries stay exact.
+        constexpr std::size_t WITNESS_SETTLE_LIMIT = 256;
+
+        // Vertices whose priority or shortcuts one worker computes at a time
+        constexpr std::size_t CONTRACT_CHUNK = 16;
+
+        constexpr long long NONE = LLONG_MAX;
+
+        struct DynamicArc {
+            int vertex;
+            long long weight;
+            int middle;
+        };
+
+        struct Shortcut {
+            int from;
+            int to;
+            long long weight;
+            int middle;
+        };
+
+        using ArcLists = std::vector<std::vector<DynamicArc>>;
+
+        // Local Dijkstra over the remaining graph. Only touched distances are reset between
+        // searches, so a search costs what it explores, not the size of the graph.
+        class WitnessSearch {
+        public:
+            template <typename Blocked>
+            void run(const ArcLists& out, std::size_t source, long long limit, const Blocked& blocked) {
+                for (std::size_t v : touched) {
+                    distance[v] = NONE;
+                }
+                touched.clear();
+                heap.clear();
+                if (distance.size() < out.size()) {
+                    distance.resize(out.size(), NONE);
+                }
+                reach(source, 0);
+                for (std::size_t settled = 0; !heap.empty() && settled < WITNESS_SETTLE_LIMIT;) {
+                    std::pop_heap(heap.begin(), heap.end(), std::greater<>());
+                    auto [d, u] = heap.back();
+                    heap.pop_back();
+                    if (d != distance[u]) {
+                        continue; // Outdated entry
+                    }
+                    ++settled;
+                    for (const DynamicArc& arc : out[u]) {
+                        std::size_t v = static_cast<std::size_t>(arc.vertex);
+                        // Paths over the limit cannot be witnesses, so they are never queued
+                        if (d + arc.weight <= limit && d + arc.weight < distance[v] && !blocked(v)) {
+                            reach(v, d + arc.weight);
+                        }
+                    }
+                }
+            }
+
+            long long at(std::size_t v) const { return distance[v]; }
+
+        private:
+            std::vector<long long> distance;
+            std::vector<std::size_t> touched;
+            std::vector<std::pair<long long, std::size_t>> heap;
+
+            void reach(std::size_t v, long long d) {
+                if (distance[v] == NONE) {
+                    touched.push_back(v);
+                }
+                distance[v] = d;
+                heap.emplace_back(d, v);
+                std::push_heap(heap.begin(), heap.end(), std::greater<>());
+            }
+        };
+
+        // The graph that remains during contraction, with in- and out-arcs per vertex
+        class Contraction {
+        public:
+            ArcLists out;
+            ArcLists in;
+            ArcLists up;   // Arcs kept from each vertex to later-contracted vertices
+            ArcLists down; // Arcs kept into each vertex from later-contracted vertices
+            std::vector<int> rank;
+
+            explicit Contraction(const SparseIndex& index)
+                : out(index.vertices()), in(index.vertices()), up(index.vertices()), down(index.vertices()),
+                  rank(index.vertices(), -1), n(index.vertices()), contracted(n, 0), inRound(n, 0),
+                  deletedNeighbors(n, 0), priority(n, 0), dirty(n, 0) {
+                for (std::size_t u = 0; u < n; ++u) {
+                    for (std::size_t e = index.offsets[u]; e < index.offsets[u + 1]; ++e) {
+                        if (index.weights[e] < 0) {
+                            throw std::invalid_argument("Contraction hierarchies require non-negative edge weights");
+                        }
+                        std::size_t v = static_cast<std::size_t>(index.indices[e]);
+                        if (v != u) { // A self loop never lies on a lightest path
+                            addArc(u, v, index.weights[e], -1);
+                        }
+                    }
+                }
+            }
+
+            void run() {
+                std::vector<WitnessSearch> searches(workerCount());
+                std::vector<std::vector<Shortcut>> scratch(workerCount());
+                std::vector<std::size_t> remaining(n);
+                for (std::size_t v = 0; v < n; ++v) {
+                    remaining[v] = v;
+                }
+                updatePriorities(remaining, searches, scratch);
+
+                int nextRank = 0;
+                std::vector<std::size_t> round;
+                std::vector<std::vector<Shortcut>> found;
+                std::vector<std::size_t> changed;
+                while (!remaining.empty()) {
+                    round.clear();
+                    for (std::size_t v : remaining) {
+                        if (isLocalMinimum(v)) {
+                            round.push_back(v);
+                            inRound[v] = 1;
+                        }
+                    }
+
+                    found.resize(round.size());
+                    parallelForDynamic(round.size(), CONTRACT_CHUNK, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+                        for (std::size_t i = begin; i < end; ++i) {
+                            found[i].clear();
+                            shortcutsOf(round[i], searches[worker], found[i], true);
+                        }
+                    });
+
+                    changed.clear();
+                    for (std::size_t v : round) {
+                        rank[v] = nextRank++;
+                        remove(v, changed);
+                    }
+                    for (std::size_t i = 0; i < round.size(); ++i) {
+                        inRound[round[i]] = 0;
+                        for (const Shortcut& shortcut : found[i]) {
+                            addArc(static_cast<std::size_t>(shortcut.from), static_cast<std::size_t>(shortcut.to),
+                                   shortcut.weight, shortcut.middle);
+                        }
+                    }
+
+                    remaining.erase(std::remove_if(remaining.begin(), remaining.end(),
+                                                   [&](std::size_t v) { return contracted[v] != 0; }),
+                                    remaining.end());
+                    for (std::size_t v : changed) {
+                        dirty[v] = 0;
+                    }
+                    changed.erase(std::remove_if(changed.begin(), changed.end(),
+                                                 [&](std::size_t v) { return contracted[v] != 0; }),
+                                  changed.end());
+                    updatePriorities(changed, searches, scratch);
+                }
+            }
+
+        private:
+            std::size_t n;
+            std::vector<char> contracted;
+            std::vector<char> inRound;
+            std::vector<int> deletedNeighbors;
+            std::vector<long long> priority;
+            std::vector<char> dirty;
+
+            // Keep only the lightest arc per (from, to) pair
+            void addArc(std::size_t from, std::size_t to, long long weight, int middle) {
+                for (DynamicArc& arc : out[from]) {
+                    if (arc.vertex == static_cast<int>(to)) {
+                        if (arc.weight <= weight) {
+                            return;
+                        }
+                        arc.weight = weight;
+                        arc.middle = middle;
+                        for (DynamicArc& back : in[to]) {
+                            if (back.vertex == static_cast<int>(from)) {
+                                back.weight = weight;
+                                back.middle = middle;
+                            }
+                        }
+                        return;
+                    }
+                }
+                out[from].push_back({static_cast<int>(to), weight, middle});
+                in[to].push_back({static_cast<int>(from), weight, middle});
+            }
+
+            // For every u->v->x, search from u around v (and, during a round, around every
+            // vertex of the round); add u->x unless a path no heavier than u->v->x exists.
+            void shortcutsOf(std::size_t v, WitnessSearch& search, std::vector<Shortcut>& found, bool blockRound) {
+                auto blocked = [&](std::size_t w) { return w == v || (blockRound && inRound[w]); };
+                for (const DynamicArc& incoming : in[v]) {
+                    long long longest = -1;
+                    for (const DynamicArc& outgoing : out[v]) {
+                        if (outgoing.vertex != incoming.vertex) {
+                            longest = std::max(longest, outgoing.weight);
+                        }
+                    }
+                    if (longest < 0) {
+                        continue;
+                    }
+                    std::size_t u = static_cast<std::size_t>(incoming.vertex);
+                    search.run(out, u, incoming.weight + longest, blocked);
+                    for (const DynamicArc& outgoing : out[v]) {
+                        long long through = incoming.weight + outgoing.weight;
+                        if (outgoing.vertex != incoming.vertex && search.at(static_cast<std::size_t>(outgoing.vertex)) > through) {
+                            found.push_back({incoming.vertex, outgoing.vertex, through, static_cast<int>(v)});
+                        }
+                    }
+                }
+            }
+
+            // Edge difference (shortcuts added minus arcs removed) plus the contracted
+            // neighbors, which spreads contraction evenly over the graph
+            void updatePriorities(const std::vector<std::size_t>& vertices, std::vector<WitnessSearch>& searches,
+                                  std::vector<std::vector<Shortcut>>& scratch) {
+                parallelForDynamic(vertices.size(), CONTRACT_CHUNK, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        std::size_t v = vertices[i];
+                        scratch[worker].clear();
+                        shortcutsOf(v, searches[worker], scratch[worker], false);
+                        priority[v] = static_cast<long long>(scratch[worker].size()) -
+                                      static_cast<long long>(in[v].size() + out[v].size()) + deletedNeighbors[v];
+                    }
+                });
+            }
+
+            // Ties go to the smaller index, so two neighbors are never in the same round
+            bool before(std::size_t a, std::size_t b) const {
+                return priority[a] < priority[b] || (priority[a] == priority[b] && a < b);
+            }
+
+            // Minimum over everything within two hops, in either direction. Vertices of a round
+            // are then at least three hops apart, so the round blocks no two-hop witness.
+            bool isLocalMinimum(std::size_t v) const {
+                auto beatsNeighbors = [&](std::size_t w, std::size_t hops, const auto& self) -> bool {
+                    for (const ArcLists* lists : {&out, &in}) {
+                        for (const DynamicArc& arc : (*lists)[w]) {
+                            std::size_t x = static_cast<std::size_t>(arc.vertex);
+                            if (x != v && (!before(v, x) || (hops > 1 && !self(x, hops - 1, self)))) {
+                                return false;
+                            }
+                        }
+                    }
+                    return true;
+                };
+                return beatsNeighbors(v, 2, beatsNeighbors);
+            }
+
+            // Move v's remaining arcs into the hierarchy and detach v from its neighbors
+            void remove(std::size_t v, std::vector<std::size_t>& changed) {
+                auto detach = [&](std::vector<DynamicArc>& arcs) {
+                    arcs.erase(std::remove_if(arcs.begin(), arcs.end(),
+                                              [&](const DynamicArc& arc) { return arc.vertex == static_cast<int>(v); }),
+                               arcs.end());
+                };
+                auto touch = [&](std::size_t w) {
+                    ++deletedNeighbors[w];
+                    if (!dirty[w]) {
+                        dirty[w] = 1;
+                        changed.push_back(w);
+                    }
+                };
+                for (const DynamicArc& arc : out[v]) {
+                    detach(in[static_cast<std::size_t>(arc.vertex)]);
+                    touch(static_cast<std::size_t>(arc.vertex));
+                }
+                for (const DynamicArc& arc : in[v]) {
+                    detach(out[static_cast<std::size_t>(arc.vertex)]);
+                    touch(static_cast<std::size_t>(arc.vertex));
+                }
+                up[v].swap(out[v]);
+                down[v].swap(in[v]);
+                contracted[v] = 1;
+            }
+        };
+
+        std::size_t checkedVertex(int vertex, std::size_t numVertices) {
+            if (vertex < 0 || static_cast<std::size_t>(vertex) >= numVertices) {
+                throw std::out_of_range("Vertex index out of range");
+            }
+            return static_cast<std::size_t>(vertex);
+        }
+    } // namespace
+
+    ContractionHierarchy::ContractionHierarchy(const Graph& graph) {
+        build(graph.csr());
+    }
+
+    ContractionHierarchy::ContractionHierarchy(const SparseIndex& out) {
+        build(out);
+    }
+
+    void ContractionHierarchy::build(const SparseIndex& out) {
+        Contraction contraction(out);
+        contraction.run();
+        numVertices = out.vertices();
+        ranks.swap(contraction.rank);
+
+        auto flatten = [](ArcLists& lists, std::vector<std::size_t>& offsets, std::vector<Arc>& arcs) {
+            offsets.assign(1, 0);
+            arcs.clear();
+            for (std::vector<DynamicArc>& list : lists) {
+                std::sort(list.begin(), list.end(),
+                          [](const DynamicArc& a, const DynamicArc& b) { return a.vertex < b.vertex; });
+                for (const DynamicArc& arc : list) {
+                    arcs.push_back({arc.vertex, arc.weight, arc.middle});
+                }
+                offsets.push_back(arcs.size());
+            }
+        };
+        flatten(contraction.up, upOffsets, upArcs);
+        flatten(contraction.down, downOffsets, downArcs);
+    }
+
+    std::size_t ContractionHierarchy::vertices() const {
+        return numVertices;
+    }
+
+    std::size_t ContractionHierarchy::shortcuts() const {
+        auto isShortcut = [](const Arc& arc) { return arc.middle != -1; };
+        return static_cast<std::size_t>(std::count_if(upArcs.begin(), upArcs.end(), isShortcut) +
+                                        std::count_if(downArcs.begin(), downArcs.end(), isShortcut));
+    }
+
+    std::size_t ContractionHierarchy::rank(std::size_t vertex) const {
+        return static_cast<std::size_t>(ranks.at(vertex));
+    }
+
+    Path ContractionHierarchy::query(int src, int dest) {
+        Path path;
+        query(src, dest, path);
+        return path;
+    }
+
+    // Both searches only climb in rank: forward along up arcs, backward along down arcs. A
+    // side stops once its smallest queued distance cannot beat the best meeting so far.
+    bool ContractionHierarchy::query(int src, int dest, Path& out) {
+        std::size_t source = checkedVertex(src, numVertices);
+        std::size_t target = checkedVertex(dest, numVertices);
+        out.vertices.clear();
+        out.cost = 0;
+        explored = 0;
+        for (std::size_t side = 0; side < 2; ++side) {
+            if (distance[side].size() != numVertices) {
+                distance[side].assign(numVertices, UNREACHABLE);
+                parent[side].assign(numVertices, -1);
+                via[side].assign(numVertices, -1);
+            }
+            queue[side].clear();
+        }
+        for (std::size_t v : touched) {
+            distance[0][v] = distance[1][v] = UNREACHABLE;
+        }
+        touched.clear();
+
+        auto reach = [&](std::size_t side, std::size_t v, long long d, std::size_t from, int middle) {
+            if (distance[0][v] == UNREACHABLE && distance[1][v] == UNREACHABLE) {
+                touched.push_back(v);
+            }
+            distance[side][v] = d;
+            parent[side][v] = static_cast<int>(from);
+            via[side][v] = middle;
+            queue[side].emplace_back(d, static_cast<int>(v));
+            std::push_heap(queue[side].begin(), queue[side].end(), std::greater<>());
+        };
+        reach(0, source, 0, source, -1);
+        reach(1, target, 0, target, -1);
+
+        long long best = source == target ? 0 : UNREACHABLE;
+        std::size_t meet = source;
+        for (std::size_t turn = 0; !queue[0].empty() || !queue[1].empty(); ++turn) {
+            std::size_t side = queue[turn % 2].empty() ? 1 - turn % 2 : turn % 2;
+            std::pop_heap(queue[side].begin(), queue[side].end(), std::greater<>());
+            auto [d, top] = queue[side].back();
+            queue[side].pop_back();
+            std::size_t u = static_cast<std::size_t>(top);
+            if (d != distance[side][u]) {
+                continue; // Outdated entry
+            }
+            if (d >= best) {
+                queue[side].clear();
+                continue;
+            }
+            ++explored;
+            const std::vector<std::size_t>& offsets = side == 0 ? upOffsets : downOffsets;
+            const std::vector<Arc>& arcs = side == 0 ? upArcs : downArcs;
+            for (std::size_t e = offsets[u]; e < offsets[u + 1]; ++e) {
+                std::size_t v = static_cast<std::size_t>(arcs[e].vertex);
+                if (d + arcs[e].weight < distance[side][v]) {
+                    reach(side, v, d + arcs[e].weight, u, arcs[e].middle);
+                }
+                long long other = distance[1 - side][v];
+                if (other != UNREACHABLE && distance[side][v] + other < best) {
+                    best = distance[side][v] + other;
+                    meet = v;
+                }
+            }
+        }
+        if (best == UNREACHABLE) {
+            return false;
+        }
+
+        // Forward tree edges from the source up to meet, then backward tree edges down to dest
+        std::vector<std::size_t> climb;
+        for (std::size_t v = meet; v != source; v = static_cast<std::size_t>(parent[0][v])) {
+            climb.push_back(v);
+        }
+        out.vertices.push_back(static_cast<int>(source));
+        for (std::size_t i = climb.size(); i-- > 0;) {
+            std::size_t v = climb[i];
+            unpack(static_cast<std::size_t>(parent[0][v]), v, via[0][v], out.vertices);
+        }
+        for (std::size_t v = meet; v != target; v = static_cast<std::size_t>(parent[1][v])) {
+            unpack(v, static_cast<std::size_t>(parent[1][v]), via[1][v], out.vertices);
+        }
+        out.cost = best;
+        return true;
+    }
+
+    // The arc from->to where one end was contracted before the other: an up arc of the lower
+    // end or a down arc of it, whichever direction it points. nullptr if there is none.
+    const ContractionHierarchy::Arc* ContractionHierarchy::findArc(std::size_t from, std::size_t to) const {
+        bool fromLower = ranks[from] < ranks[to];
+        std::size_t owner = fromLower ? from : to;
+        std::size_t other = fromLower ? to : from;
+        const std::vector<std::size_t>& offsets = fromLower ? upOffsets : downOffsets;
+        const std::vector<Arc>& arcs = fromLower ? upArcs : downArcs;
+        auto first = arcs.begin() + static_cast<std::ptrdiff_t>(offsets[owner]);
+        auto last = arcs.begin() + static_cast<std::ptrdiff_t>(offsets[owner + 1]);
+        auto found = std::lower_bound(first, last, static_cast<int>(other),
+                                      [](const Arc& arc, int vertex) { return arc.vertex < vertex; });
+        if (found == last || found->vertex != static_cast<int>(other)) {
+            return nullptr;
+        }
+        return &*found;
+    }
+
+    int ContractionHierarchy::middleOf(std::size_t from, std::size_t to) const {
+        const Arc* arc = findArc(from, to);
+        if (arc == nullptr) {
+            throw std::logic_error("Contraction hierarchy lacks half of a shortcut");
+        }
+        return arc->middle;
+    }
+
+    // What queries and unpacking rely on: ranks are a permutation, each vertex's arcs are
+    // sorted by vertex and lead to higher ranks, and every shortcut skips a vertex ranked
+    // below both of its ends whose two arcs exist. The last rule makes unpacking terminate.
+    void ContractionHierarchy::validate() const {
+        std::vector<char> seen(numVertices, 0);
+        for (int rank : ranks) {
+            if (seen[static_cast<std::size_t>(rank)]) {
+                throw std::invalid_argument("Invalid input: repeated vertex rank.");
+            }
+            seen[static_cast<std::size_t>(rank)] = 1;
+        }
+        for (bool up : {true, false}) {
+            const std::vector<std::size_t>& offsets = up ? upOffsets : downOffsets;
+            const std::vector<Arc>& arcs = up ? upArcs : downArcs;
+            for (std::size_t v = 0; v < numVertices; ++v) {
+                for (std::size_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+                    std::size_t w = static_cast<std::size_t>(arcs[e].vertex);
+                    if (ranks[w] <= ranks[v]) {
+                        throw std::invalid_argument("Invalid input: arc does not lead to a higher rank.");
+                    }
+                    if (e > offsets[v] && arcs[e - 1].vertex >= arcs[e].vertex) {
+                        throw std::invalid_argument("Invalid input: arcs not sorted by vertex.");
+                    }
+                }
+            }
+        }
+        for (bool up : {true, false}) {
+            const std::vector<std::size_t>& offsets = up ? upOffsets : downOffsets;
+            const std::vector<Arc>& arcs = up ? upArcs : downArcs;
+            for (std::size_t v = 0; v < numVertices; ++v) {
+                for (std::size_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+                    if (arcs[e].middle == -1) {
+                        continue;
+                    }
+                    std::size_t w = static_cast<std::size_t>(arcs[e].vertex);
+                    std::size_t skipped = static_cast<std::size_t>(arcs[e].middle);
+                    std::size_t from = up ? v : w;
+                    std::size_t to = up ? w : v;
+                    if (ranks[skipped] >= ranks[v] || findArc(from, skipped) == nullptr ||
+                        findArc(skipped, to) == nullptr) {
+                        throw std::invalid_argument("Invalid input: shortcut without both halves.");
+                    }
+                }
+            }
+        }
+    }
+
+    // Append the original vertices of arc from->to (excluding from) to path
+    void ContractionHierarchy::unpack(std::size_t from, std::size_t to, int middle, std::vector<int>& path) const {
+        std::vector<Shortcut> pending{{static_cast<int>(from), static_cast<int>(to), 0, middle}};
+        while (!pending.empty()) {
+            Shortcut arc = pending.back();
+            pending.pop_back();
+            if (arc.middle == -1) {
+                path.push_back(arc.to);
+                continue;
+            }
+            std::size_t skipped = static_cast<std::size_t>(arc.middle);
+            pending.push_back({arc.middle, arc.to, 0, middleOf(skipped, static_cast<std::size_t>(arc.to))});
+            pending.push_back({arc.from, arc.middle, 0, middleOf(static_cast<std::size_t>(arc.from), skipped)});
+        }
+    }
+
+    std::ostream& operator<<(std::ostream& os, const ContractionHierarchy& hierarchy) {
+        auto writeArcs = [&os](const std::vector<std::size_t>& offsets, const std::vector<ContractionHierarchy::Arc>& arcs,
+                               std::size_t v) {
+            os << ' ' << offsets[v + 1] - offsets[v];
+            for (std::size_t e = offsets[v]; e < offsets[v + 1]; ++e) {
+                os << ' ' << arcs[e].vertex << ' ' << arcs[e].weight << ' ' << arcs[e].middle;
+            }
+        };
+        os << "CH 1\n" << hierarchy.numVertices << '\n';
+        for (std::size_t v = 0; v < hierarchy.numVertices; ++v) {
+            os << (v > 0 ? " " : "") << hierarchy.ranks[v];
+        }
+        os << '\n';
+        for (std::size_t v = 0; v < hierarchy.numVertices; ++v) {
+            os << v << ':';
+            writeArcs(hierarchy.upOffsets, hierarchy.upArcs, v);
+            writeArcs(hierarchy.downOffsets, hierarchy.downArcs, v);
+            os << '\n';
+        }
+        return os;
+    }
+
+    std::istream& operator>>(std::istream& is, ContractionHierarchy& hierarchy) {
+        std::string magic;
+        int version = 0;
+        std::size_t n = 0;
+        if (!(is >> magic >> version >> n) || magic != "CH" || version != 1) {
+            throw std::invalid_argument("Invalid input: not a contraction hierarchy.");
+        }
+        std::vector<int> ranks(n);
+        for (int& rank : ranks) {
+            if (!(is >> rank) || rank < 0 || static_cast<std::size_t>(rank) >= n) {
+                throw std::invalid_argument("Invalid input: bad vertex rank.");
+            }
+        }
+        auto readArcs = [&is, n](std::vector<std::size_t>& offsets, std::vector<ContractionHierarchy::Arc>& arcs) {
+            std::size_t count = 0;
+            if (!(is >> count)) {
+                throw std::invalid_argument("Invalid input: missing arc count.");
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                ContractionHierarchy::Arc arc{};
+                if (!(is >> arc.vertex >> arc.weight >> arc.middle) || arc.vertex < 0 ||
+                    static_cast<std::size_t>(arc.vertex) >= n || arc.weight < 0 || arc.middle < -1 ||
+                    arc.middle >= static_cast<int>(n)) {
+                    throw std::invalid_argument("Invalid input: bad arc.");
+                }
+                arcs.push_back(arc);
+            }
+            offsets.push_back(arcs.size());
+        };
+        std::vector<std::size_t> upOffsets(1, 0);
+        std::vector<std::size_t> downOffsets(1, 0);
+        std::vector<ContractionHierarchy::Arc> upArcs;
+        std::vector<ContractionHierarchy::Arc> downArcs;
+        for (std::size_t v = 0; v < n; ++v) {
+            std::size_t label = 0;
+            char colon = 0;
+            if (!(is >> label >> colon) || label != v || colon != ':') {
+                throw std::invalid_argument("Invalid input: hierarchy rows out of order.");
+            }
+            readArcs(upOffsets, upArcs);
+            readArcs(downOffsets, downArcs);
+        }
+        // Validate a fresh hierarchy so a rejected file leaves the target untouched; its
+        // query workspace starts empty and is sized again by the next query
+        ContractionHierarchy loaded;
+        loaded.numVertices = n;
+        loaded.ranks.swap(ranks);
+        loaded.upOffsets.swap(upOffsets);
+        loaded.upArcs.swap(upArcs);
+        loaded.downOffsets.swap(downOffsets);
+        loaded.downArcs.swap(downArcs);
+        loaded.validate();
+        hierarchy = std::move(loaded);
+        return is;
+    }
+
+} // namespace ariel
@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Algorithms.hpp"
+#include "Graph.hpp"
+#include "SparseIndex.hpp"
+#include <climits>
+#include <cstddef>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#ifndef CPP_EX4_CONTRACTIONHIERARCHY_HPP
+#define CPP_EX4_CONTRACTIONHIERARCHY_HPP
+
+namespace ariel {
+    /**
+     * @brief Contraction hierarchy: a shortest-path index for static graphs.
+     *
+     * Preprocessing removes (contracts) the vertices in order of importance. Removing v adds
+     * a shortcut u->x for every path u->v->x that has no equally light detour (witness)
+     * around v. Each round contracts, in parallel, every vertex whose priority (edge
+     * difference plus contracted neighbors) is smaller than that of all remaining vertices
+     * within two hops. Witness searches avoid every vertex of the round, so the vertices of
+     * a round never rely on each other's shortcuts.
+     *
+     * A query runs Dijkstra upwards in rank from both ends and takes the lightest meeting
+     * vertex. Shortcuts on the result are then unpacked back into original edges.
+     *
+     * The index can be written with operator<< and read back with operator>>.
+     */
+    class ContractionHierarchy {
+    public:
+        static constexpr long long UNREACHABLE = LLONG_MAX;
+
+        std::size_t explored = 0; // Vertices settled by the last query, both directions together
+
+        /**
+         * @brief Empty hierarchy, to be filled by operator>>.
+         */
+        ContractionHierarchy() = default;
+
+        /**
+         * @brief Contract a graph.
+         *
+         * @param graph The graph; weights must be non-negative.
+         * @throw std::invalid_argument If the graph has a negative edge.
+         */
+        explicit ContractionHierarchy(const Graph& graph);
+
+        /**
+         * @brief Contract a graph given as a CSR index.
+         *
+         * @param out The CSR index of the graph (see Graph::csr()); weights must be non-negative.
+         * @throw std::invalid_argument If the index has a negative weight.
+         */
+        explicit ContractionHierarchy(const SparseIndex& out);
+
+        /**
+         * @brief Get the number of vertices in the hierarchy.
+         *
+         * @return The number of vertices.
+         */
+        std::size_t vertices() const;
+
+        /**
+         * @brief Get the number of shortcut edges added by the contraction.
+         *
+         * @return The number of shortcuts.
+         */
+        std::size_t shortcuts() const;
+
+        /**
+         * @brief Get the contraction rank of a vertex (0 is contracted first).
+         *
+         * @param vertex The vertex.
+         * @return The rank.
+         */
+        std::size_t rank(std::size_t vertex) const;
+
+        /**
+         * @brief Find the lightest path between two vertices.
+         *
+         * @param src The source vertex.
+         * @param dest The destination vertex.
+         * @param out Receives the unpacked path and its cost; its buffer is reused.
+         * @return True if dest is reachable from src.
+         * @throw std::out_of_range If src or dest is not a vertex of the hierarchy.
+         */
+        bool query(int src, int dest, Path& out);
+
+        /**
+         * @brief Find the lightest path between two vertices.
+         *
+         * @param src The source vertex.
+         * @param dest The destination vertex.
+         * @return The unpacked path, empty if dest is not reachable.
+         * @throw std::out_of_range If src or dest is not a vertex of the hierarchy.
+         */
+        Path query(int src, int dest);
+
+        // Text format: "CH 1", the vertex count, the ranks, then one line per vertex with its
+        // upward arcs and its downward arcs as "count (vertex weight middle)*" (middle -1 for
+        // an original edge). Reading throws std::invalid_argument on malformed text and on an
+        // index that breaks the invariants queries rely on (see validate()).
+        friend std::ostream& operator<<(std::ostream& os, const ContractionHierarchy& hierarchy);
+        friend std::istream& operator>>(std::istream& is, ContractionHierarchy& hierarchy);
+
+    private:
+        struct Arc {
+            int vertex;
+            long long weight;
+            int middle; // Vertex the shortcut skips, -1 for an original edge
+        };
+
+        std::size_t numVertices = 0;
+        std::vector<int> ranks;
+        // up[v]: arcs v->x to higher-ranked x; down[v]: arcs u->v from higher-ranked u.
+        // Both are sorted by vertex so shortcuts can be unpacked by binary search.
+        std::vector<std::size_t> upOffsets;
+        std::vector<Arc> upArcs;
+        std::vector<std::size_t> downOffsets;
+        std::vector<Arc> downArcs;
+
+        // Query workspace; only entries in touched differ from the reset state
+        std::vector<long long> distance[2];
+        std::vector<int> parent[2];
+        std::vector<int> via[2];
+        std::vector<std::pair<long long, int>> queue[2];
+        std::vector<std::size_t> touched;
+
+        void build(const SparseIndex& out);
+        void validate() const;
+        const Arc* findArc(std::size_t from, std::size_t to) const;
+        int middleOf(std::size_t from, std::size_t to) const;
+        void unpack(std::size_t from, std::size_t to, int middle, std::vector<int>& path) const;
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_CONTRACTIONHIERARCHY_HPP
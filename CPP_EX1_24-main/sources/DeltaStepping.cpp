@@ -0,0 +1,170 @@
+#include "DeltaStepping.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <stdexcept>
+
+namespace ariel {
+
+    namespace {
+        // Vertices of a bucket claimed at a time by one worker
+        constexpr std::size_t RELAX_CHUNK = 256;
+    } // namespace
+
+    long long DeltaStepping::autoDelta(const SparseIndex& out) {
+        std::size_t n = out.vertices();
+        std::size_t m = out.nonZeros();
+        if (n == 0 || m == 0) {
+            return 1;
+        }
+        long long maxWeight = *std::max_element(out.weights.begin(), out.weights.end());
+        long long delta = maxWeight * static_cast<long long>(n) / static_cast<long long>(m);
+        return std::max(1LL, delta);
+    }
+
+    void DeltaStepping::push(std::size_t bucket, std::size_t vertex) {
+        std::size_t slot = bucket % buckets.size();
+        buckets[slot].push_back(vertex);
+        occupied[slot / 64] |= std::uint64_t{1} << (slot % 64);
+    }
+
+    // Smallest bucket index >= bucket whose ring slot holds entries; every queued entry lies
+    // less than one ring ahead, so the first set bit going round the ring is the one
+    std::size_t DeltaStepping::nextOccupied(std::size_t bucket) const {
+        std::size_t ringSize = buckets.size();
+        std::size_t start = bucket % ringSize;
+        for (std::size_t step = 0; step <= occupied.size(); ++step) {
+            std::size_t word = (start / 64 + step) % occupied.size();
+            std::uint64_t bits = occupied[word];
+            if (step == 0) {
+                bits &= ~std::uint64_t{0} << (start % 64); // Skip the slots before start
+            } else if (step == occupied.size()) {
+                bits &= (std::uint64_t{1} << (start % 64)) - 1; // Wrapped round to start's word
+            }
+            if (bits != 0) {
+                std::size_t slot = word * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+                return bucket + (slot + ringSize - start) % ringSize;
+            }
+        }
+        return bucket; // Unreachable while entries are queued
+    }
+
+    // Partition every row so light edges come first; each phase then scans only the half it needs
+    void DeltaStepping::splitEdges(const SparseIndex& out, long long delta) {
+        std::size_t n = out.vertices();
+        split.offsets = out.offsets;
+        split.indices.resize(out.nonZeros());
+        split.weights.resize(out.nonZeros());
+        lightEnd.assign(n, 0);
+        parallelFor(n, 1 << 12, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t u = begin; u < end; ++u) {
+                std::size_t light = out.offsets[u];
+                std::size_t heavy = out.offsets[u + 1];
+                for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                    std::size_t slot = out.weights[e] <= delta ? light++ : --heavy;
+                    split.indices[slot] = out.indices[e];
+                    split.weights[slot] = out.weights[e];
+                }
+                lightEnd[u] = light;
+            }
+        });
+    }
+
+    // Relax the light or heavy edges of the given vertices in parallel. A relaxation that
+    // lowers a distance wins a CAS on it and records the target in the worker's list.
+    void DeltaStepping::relax(const std::vector<std::size_t>& vertices, bool light, std::vector<long long>& distance) {
+        improved.resize(workerCount());
+        for (auto& list : improved) {
+            list.clear();
+        }
+        parallelForDynamic(vertices.size(), RELAX_CHUNK, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+            std::vector<std::size_t>& list = improved[worker];
+            for (std::size_t i = begin; i < end; ++i) {
+                std::size_t u = vertices[i];
+                long long base = std::atomic_ref<long long>(distance[u]).load(std::memory_order_relaxed);
+                std::size_t first = light ? split.offsets[u] : lightEnd[u];
+                std::size_t last = light ? lightEnd[u] : split.offsets[u + 1];
+                for (std::size_t e = first; e < last; ++e) {
+                    std::size_t v = static_cast<std::size_t>(split.indices[e]);
+                    long long candidate = base + split.weights[e];
+                    std::atomic_ref<long long> target(distance[v]);
+                    long long current = target.load(std::memory_order_relaxed);
+                    while (candidate < current &&
+                           !target.compare_exchange_weak(current, candidate, std::memory_order_relaxed)) {
+                    }
+                    if (candidate < current) {
+                        list.push_back(v);
+                    }
+                }
+            }
+        });
+    }
+
+    std::vector<long long> DeltaStepping::run(const SparseIndex& out, std::size_t source, long long delta) {
+        std::size_t n = out.vertices();
+        if (std::any_of(out.weights.begin(), out.weights.end(), [](int w) { return w < 0; })) {
+            throw std::invalid_argument("Delta-stepping requires non-negative edge weights");
+        }
+        if (delta <= 0) {
+            delta = autoDelta(out);
+        }
+        // Every queued distance lies within maxWeight + delta of the current bucket, so a
+        // ring of this many buckets never wraps onto a live one. Widen delta until it fits.
+        long long maxWeight = out.nonZeros() == 0 ? 0 : *std::max_element(out.weights.begin(), out.weights.end());
+        long long ringLimit = static_cast<long long>(MAX_BUCKETS) - 2;
+        delta = std::max(delta, (maxWeight + ringLimit - 1) / ringLimit);
+        splitEdges(out, delta);
+        std::size_t ringSize = static_cast<std::size_t>(maxWeight / delta) + 2;
+        buckets.assign(ringSize, {});
+        occupied.assign((ringSize + 63) / 64, 0);
+        frontierStamp.assign(n, 0);
+        settledStamp.assign(n, 0);
+
+        std::vector<long long> distance(n, UNREACHABLE);
+        distance[source] = 0;
+        push(0, source);
+        std::size_t queued = 1;
+        std::size_t phase = 0;
+        auto enqueue = [&]() {
+            for (const auto& list : improved) {
+                for (std::size_t v : list) {
+                    push(static_cast<std::size_t>(distance[v] / delta), v);
+                    ++queued;
+                }
+            }
+        };
+
+        for (std::size_t bucket = 0; queued > 0; ++bucket) {
+            bucket = nextOccupied(bucket);
+            std::vector<std::size_t>& slot = buckets[bucket % ringSize];
+            settled.clear();
+            ++phase;
+            while (!slot.empty()) {
+                // Keep entries whose current distance still falls in this bucket, once each
+                ++phase;
+                frontier.clear();
+                for (std::size_t v : slot) {
+                    if (static_cast<std::size_t>(distance[v] / delta) == bucket && frontierStamp[v] != phase) {
+                        frontierStamp[v] = phase;
+                        frontier.push_back(v);
+                        if (settledStamp[v] != bucket + 1) {
+                            settledStamp[v] = bucket + 1;
+                            settled.push_back(v);
+                        }
+                    }
+                }
+                queued -= slot.size();
+                slot.clear();
+                relax(frontier, true, distance);
+                enqueue();
+            }
+            // Heavy edges land at least one bucket further on, never back in this slot
+            occupied[bucket % ringSize / 64] &= ~(std::uint64_t{1} << (bucket % ringSize % 64));
+            relax(settled, false, distance);
+            enqueue();
+        }
+        return distance;
+    }
+
+} // namespace ariel
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "SparseIndex.hpp"
+#include <cstddef>
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+#ifndef CPP_EX4_DELTASTEPPING_HPP
+#define CPP_EX4_DELTASTEPPING_HPP
+
+namespace ariel {
+    /**
+     * @brief Parallel single-source shortest paths by delta-stepping (Meyer and Sanders).
+     *
+     * Tentative distances are kept in buckets of width delta. Each bucket is emptied by
+     * repeatedly relaxing the light edges (weight <= delta) of its vertices in parallel,
+     * after which the heavy edges of every vertex it settled are relaxed once. Relaxations
+     * use an atomic minimum on the 64-bit distance, so the result does not depend on the
+     * number of workers.
+     *
+     * The ring holds at most MAX_BUCKETS buckets, so a caller-supplied delta far below the
+     * largest weight is raised to fit. An occupancy bitmap lets the scan jump over runs of
+     * empty buckets.
+     */
+    class DeltaStepping {
+    public:
+        static constexpr long long UNREACHABLE = LLONG_MAX;
+        // Upper bound on the ring of buckets
+        static constexpr std::size_t MAX_BUCKETS = std::size_t{1} << 16;
+
+        /**
+         * @brief Pick a bucket width from the weight distribution: maxWeight / averageDegree.
+         *
+         * @param out The CSR index of the graph.
+         * @return The bucket width, at least 1.
+         */
+        static long long autoDelta(const SparseIndex& out);
+
+        /**
+         * @brief Compute distances from source.
+         *
+         * @param out The CSR index of the graph; weights must be non-negative.
+         * @param source The source vertex.
+         * @param delta The bucket width, or 0 to use autoDelta(out). Raised to at least
+         *        maxWeight / (MAX_BUCKETS - 2); distances do not depend on it.
+         * @return The distance to every vertex, UNREACHABLE if it is not reachable.
+         * @throw std::invalid_argument If the index holds a negative weight.
+         */
+        std::vector<long long> run(const SparseIndex& out, std::size_t source, long long delta = 0);
+
+    private:
+        std::vector<std::size_t> lightEnd;   // Edges [offsets[u], lightEnd[u]) of the split index are light
+        SparseIndex split;                   // Copy of the input with each row partitioned light-first
+        std::vector<std::vector<std::size_t>> buckets;
+        std::vector<std::uint64_t> occupied; // One bit per ring slot that holds entries
+        std::vector<std::vector<std::size_t>> improved; // Per-worker vertices whose distance dropped
+        std::vector<std::size_t> frontier;
+        std::vector<std::size_t> settled;
+        std::vector<std::size_t> frontierStamp;
+        std::vector<std::size_t> settledStamp;
+
+        void push(std::size_t bucket, std::size_t vertex);
+        std::size_t nextOccupied(std::size_t bucket) const;
+        void splitEdges(const SparseIndex& out, long long delta);
+        void relax(const std::vector<std::size_t>& vertices, bool light, std::vector<long long>& distance);
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_DELTASTEPPING_HPP
@@ -0,0 +1,146 @@
+#include "DifferenceConstraints.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ariel {
+
+    DifferenceConstraints::DifferenceConstraints(std::size_t variables)
+        : value(variables, 0), out(variables), drop(variables, 0), parent(variables, -1), settled(variables, 0) {}
+
+    std::size_t DifferenceConstraints::variables() const {
+        return value.size();
+    }
+
+    std::size_t DifferenceConstraints::constraints() const {
+        return count;
+    }
+
+    const std::vector<long long>& DifferenceConstraints::assignment() const {
+        return value;
+    }
+
+    const std::vector<int>& DifferenceConstraints::conflict() const {
+        return certificate;
+    }
+
+    std::size_t DifferenceConstraints::checkedVariable(int variable) const {
+        if (variable < 0 || static_cast<std::size_t>(variable) >= value.size()) {
+            throw std::out_of_range("Variable index out of range");
+        }
+        return static_cast<std::size_t>(variable);
+    }
+
+    void DifferenceConstraints::resetWorkspace() {
+        for (std::size_t v : touched) {
+            drop[v] = 0;
+            parent[v] = -1;
+            settled[v] = 0;
+        }
+        touched.clear();
+        heap.clear();
+    }
+
+    bool DifferenceConstraints::add(const Constraint& constraint) {
+        std::size_t from = checkedVariable(constraint.from);
+        std::size_t to = checkedVariable(constraint.to);
+        if (value[to] - value[from] <= constraint.bound) {
+            out[from].emplace_back(to, constraint.bound);
+            ++count;
+            return true;
+        }
+        certificate.clear();
+        if (from == to) {
+            certificate.push_back(constraint.from); // A negative bound on x - x
+            return false;
+        }
+
+        // drop[v]: how far v must fall. Largest first, and a drop only shrinks by the
+        // reduced cost (>= 0) of each edge it crosses, so every pop is final.
+        drop[to] = value[to] - value[from] - constraint.bound;
+        parent[to] = static_cast<int>(from);
+        touched.push_back(to);
+        heap.emplace_back(drop[to], to);
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end());
+            auto [amount, u] = heap.back();
+            heap.pop_back();
+            if (settled[u] || amount != drop[u]) {
+                continue;
+            }
+            settled[u] = 1;
+            for (const auto& [v, bound] : out[u]) {
+                long long remaining = amount - (value[u] + bound - value[v]);
+                if (remaining <= drop[v]) {
+                    continue;
+                }
+                if (v == from) {
+                    // from would have to fall too, pulling to down again: the new edge closes
+                    // the negative cycle from -> to -> ... -> u -> from
+                    for (std::size_t w = u; w != to; w = static_cast<std::size_t>(parent[w])) {
+                        certificate.push_back(static_cast<int>(w));
+                    }
+                    certificate.push_back(static_cast<int>(to));
+                    certificate.push_back(static_cast<int>(from));
+                    std::reverse(certificate.begin(), certificate.end());
+                    resetWorkspace();
+                    return false;
+                }
+                if (drop[v] == 0) {
+                    touched.push_back(v);
+                }
+                drop[v] = remaining;
+                parent[v] = static_cast<int>(u);
+                heap.emplace_back(remaining, v);
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+        for (std::size_t v : touched) {
+            value[v] -= drop[v];
+        }
+        resetWorkspace();
+        out[from].emplace_back(to, constraint.bound);
+        ++count;
+        return true;
+    }
+
+    bool DifferenceConstraints::add(const std::vector<Constraint>& batch) {
+        for (const Constraint& constraint : batch) {
+            checkedVariable(constraint.from);
+            checkedVariable(constraint.to);
+        }
+        std::size_t n = value.size();
+        // CSR of the accepted constraints plus the batch; parallel constraints keep the
+        // tightest bound
+        std::vector<std::vector<std::pair<std::size_t, int>>> rows = out;
+        for (const Constraint& constraint : batch) {
+            rows[static_cast<std::size_t>(constraint.from)].emplace_back(static_cast<std::size_t>(constraint.to),
+                                                                         constraint.bound);
+        }
+        SparseIndex index;
+        index.offsets.assign(n + 1, 0);
+        for (std::size_t u = 0; u < n; ++u) {
+            std::vector<std::pair<std::size_t, int>>& row = rows[u];
+            std::sort(row.begin(), row.end());
+            for (std::size_t i = 0; i < row.size(); ++i) {
+                if (i == 0 || row[i].first != row[i - 1].first) {
+                    index.indices.push_back(static_cast<int>(row[i].first));
+                    index.weights.push_back(row[i].second);
+                }
+            }
+            index.offsets[u + 1] = index.indices.size();
+        }
+
+        certificate.clear();
+        if (!engine.runFromAll(index)) {
+            certificate = engine.cycle;
+            return false;
+        }
+        value = engine.distance;
+        for (const Constraint& constraint : batch) {
+            out[static_cast<std::size_t>(constraint.from)].emplace_back(static_cast<std::size_t>(constraint.to),
+                                                                        constraint.bound);
+        }
+        count += batch.size();
+        return true;
+    }
+} // namespace ariel
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "BellmanFord.hpp"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#ifndef CPP_EX4_DIFFERENCECONSTRAINTS_HPP
+#define CPP_EX4_DIFFERENCECONSTRAINTS_HPP
+
+namespace ariel {
+    /**
+     * @brief A system of difference constraints x[to] - x[from] <= bound, kept feasible.
+     *
+     * Each constraint is an edge from -> to of weight bound. The system is feasible exactly
+     * when that graph has no negative cycle, and the distances from a virtual source joined
+     * to every variable are then a solution.
+     *
+     * The current solution doubles as a set of potentials: every accepted constraint has
+     * reduced cost x[from] + bound - x[to] >= 0. Adding a violated constraint only lowers
+     * the variables it pushes down, found by a Dijkstra over reduced costs from its target
+     * that is keyed by how far each variable must drop. Reaching the constraint's own source
+     * means the new edge closes a negative cycle. A constraint that is already satisfied
+     * costs O(1); otherwise the cost is that of a Dijkstra over the affected variables only.
+     */
+    class DifferenceConstraints {
+    public:
+        struct Constraint {
+            int from;
+            int to;
+            int bound; // x[to] - x[from] <= bound
+        };
+
+        /**
+         * @brief Create an empty system; every variable starts at 0.
+         *
+         * @param variables The number of variables.
+         */
+        explicit DifferenceConstraints(std::size_t variables);
+
+        /**
+         * @brief Get the number of variables.
+         *
+         * @return The number of variables.
+         */
+        std::size_t variables() const;
+
+        /**
+         * @brief Get the number of accepted constraints.
+         *
+         * @return The number of constraints.
+         */
+        std::size_t constraints() const;
+
+        /**
+         * @brief Add one constraint, re-solving from the current assignment.
+         *
+         * @param constraint The constraint.
+         * @return True if the system stays feasible. Otherwise the constraint is rejected,
+         *         the assignment is unchanged and conflict() holds the certificate.
+         * @throw std::out_of_range If the constraint names a variable outside the system.
+         */
+        bool add(const Constraint& constraint);
+
+        /**
+         * @brief Add a batch of constraints and re-solve with Bellman-Ford.
+         *
+         * Cheaper than repeated add() when the batch rewrites most of the assignment.
+         *
+         * @param batch The constraints.
+         * @return True if the system stays feasible. Otherwise the whole batch is rejected,
+         *         the assignment is unchanged and conflict() holds the certificate.
+         * @throw std::out_of_range If a constraint names a variable outside the system.
+         */
+        bool add(const std::vector<Constraint>& batch);
+
+        /**
+         * @brief Get the current feasible assignment.
+         *
+         * @return One value per variable, all at most 0.
+         */
+        const std::vector<long long>& assignment() const;
+
+        /**
+         * @brief Get the infeasibility certificate of the last rejected addition.
+         *
+         * @return Variables v0, ..., vk with a constraint from each to the next and from vk
+         *         back to v0, whose bounds sum to a negative number (empty if no addition
+         *         has been rejected).
+         */
+        const std::vector<int>& conflict() const;
+
+    private:
+        std::vector<long long> value;
+        // out[from]: (to, bound) of the accepted constraints
+        std::vector<std::vector<std::pair<std::size_t, int>>> out;
+        std::size_t count = 0;
+        std::vector<int> certificate;
+        BellmanFord engine;
+
+        // Incremental workspace; only entries in touched differ from the reset state
+        std::vector<long long> drop;
+        std::vector<int> parent;
+        std::vector<char> settled;
+        std::vector<std::size_t> touched;
+        std::vector<std::pair<long long, std::size_t>> heap;
+
+        std::size_t checkedVariable(int variable) const;
+        void resetWorkspace();
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_DIFFERENCECONSTRAINTS_HPP
@@ -0,0 +1,280 @@
+#pragma once
+
+#include "Algorithms.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#ifndef CPP_EX4_DIJKSTRA_HPP
+#define CPP_EX4_DIJKSTRA_HPP
+
+namespace ariel {
+    /**
+     * @brief Monotone priority queue for non-negative integer keys.
+     *
+     * Bucket i holds keys that first differ from the last extracted key at bit i - 1, so a
+     * key moves down at most 64 times over its lifetime and each operation is amortized
+     * O(log C). Keys pushed must not be smaller than the last key popped, which Dijkstra
+     * guarantees. There is no decrease-key: stale entries are skipped by the caller.
+     */
+    class RadixHeap {
+    public:
+        bool empty() const { return count == 0; }
+
+        void clear() {
+            for (auto& bucket : buckets) {
+                bucket.clear();
+            }
+            last = 0;
+            count = 0;
+        }
+
+        void push(std::uint64_t key, std::size_t value) {
+            buckets[bucketOf(key)].emplace_back(key, value);
+            ++count;
+        }
+
+        std::pair<std::uint64_t, std::size_t> pop() {
+            if (buckets[0].empty()) {
+                std::size_t i = 1;
+                while (buckets[i].empty()) {
+                    ++i;
+                }
+                std::uint64_t smallest = buckets[i][0].first;
+                for (const auto& item : buckets[i]) {
+                    smallest = std::min(smallest, item.first);
+                }
+                last = smallest;
+                for (const auto& item : buckets[i]) {
+                    buckets[bucketOf(item.first)].push_back(item);
+                }
+                buckets[i].clear();
+            }
+            auto item = buckets[0].back();
+            buckets[0].pop_back();
+            --count;
+            return item;
+        }
+
+    private:
+        std::array<std::vector<std::pair<std::uint64_t, std::size_t>>, 65> buckets;
+        std::uint64_t last = 0;
+        std::size_t count = 0;
+
+        std::size_t bucketOf(std::uint64_t key) const {
+            return key == last ? 0 : static_cast<std::size_t>(64 - std::countl_zero(key ^ last));
+        }
+    };
+
+    /**
+     * @brief 4-ary min-heap of vertices keyed by an external distance array, with decrease-key.
+     *
+     * A wider node than a binary heap halves the tree height and keeps the children of a
+     * node in one cache line.
+     */
+    class DAryHeap {
+    public:
+        void reset(std::size_t n) {
+            heap.clear();
+            position.assign(n, NOT_IN_HEAP);
+        }
+
+        bool empty() const { return heap.empty(); }
+
+        std::size_t size() const { return heap.size(); }
+
+        // Vertex with the smallest key; the heap must not be empty
+        std::size_t top() const { return heap[0]; }
+
+        // Insert v, or move it up after its key decreased
+        void pushOrDecrease(std::size_t v, const std::vector<long long>& key) {
+            if (position[v] == NOT_IN_HEAP) {
+                position[v] = heap.size();
+                heap.push_back(v);
+            }
+            siftUp(position[v], key);
+        }
+
+        std::size_t pop(const std::vector<long long>& key) {
+            std::size_t top = heap[0];
+            position[top] = NOT_IN_HEAP;
+            std::size_t moved = heap.back();
+            heap.pop_back();
+            if (!heap.empty()) {
+                heap[0] = moved;
+                position[moved] = 0;
+                siftDown(0, key);
+            }
+            return top;
+        }
+
+    private:
+        static constexpr std::size_t ARITY = 4;
+        static constexpr std::size_t NOT_IN_HEAP = static_cast<std::size_t>(-1);
+
+        std::vector<std::size_t> heap;
+        std::vector<std::size_t> position;
+
+        void place(std::size_t slot, std::size_t v) {
+            heap[slot] = v;
+            position[v] = slot;
+        }
+
+        void siftUp(std::size_t slot, const std::vector<long long>& key) {
+            std::size_t v = heap[slot];
+            while (slot > 0) {
+                std::size_t up = (slot - 1) / ARITY;
+                if (key[heap[up]] <= key[v]) {
+                    break;
+                }
+                place(slot, heap[up]);
+                slot = up;
+            }
+            place(slot, v);
+        }
+
+        void siftDown(std::size_t slot, const std::vector<long long>& key) {
+            std::size_t v = heap[slot];
+            for (;;) {
+                std::size_t first = slot * ARITY + 1;
+                if (first >= heap.size()) {
+                    break;
+                }
+                std::size_t best = first;
+                for (std::size_t child = first + 1; child < std::min(first + ARITY, heap.size()); ++child) {
+                    if (key[heap[child]] < key[heap[best]]) {
+                        best = child;
+                    }
+                }
+                if (key[heap[best]] >= key[v]) {
+                    break;
+                }
+                place(slot, heap[best]);
+                slot = best;
+            }
+            place(slot, v);
+        }
+    };
+
+    /**
+     * @brief Reusable single-source Dijkstra over a DenseAdjacency or SparseAdjacency.
+     *
+     * Any adjacency with vertices() and forEachOut(u, visit(v, weight)) works; weights may
+     * be wider than int (Johnson's reweighted edges are long long).
+     *
+     * Keep one engine per thread and reuse it: its distance arrays and heap storage are
+     * only reallocated when the graph grows.
+     */
+    class DijkstraEngine {
+    public:
+        enum class HeapKind { Radix, DAry };
+
+        static constexpr long long UNREACHABLE = LLONG_MAX;
+        static constexpr std::size_t NO_TARGET = static_cast<std::size_t>(-1);
+
+        std::vector<long long> distance; // UNREACHABLE if not reached
+        std::vector<int> parent;         // -1 if not reached; the source is its own parent
+
+        explicit DijkstraEngine(HeapKind heapKind = HeapKind::Radix) : heapKind(heapKind) {}
+
+        /**
+         * @brief Compute distances from source, stopping once target is settled.
+         *
+         * @return False if a negative edge was reached (distances are then meaningless).
+         */
+        template <typename Adjacency>
+        bool run(const Adjacency& adjacency, std::size_t source, std::size_t target = NO_TARGET) {
+            std::size_t n = adjacency.vertices();
+            distance.assign(n, UNREACHABLE);
+            parent.assign(n, -1);
+            settled.assign(n, 0);
+            distance[source] = 0;
+            parent[source] = static_cast<int>(source);
+            radix.clear();
+            dary.reset(n);
+            push(source);
+
+            bool negative = false;
+            while (!negative && !queueEmpty()) {
+                std::size_t u = pop();
+                if (u == NO_TARGET) {
+                    continue; // Stale radix entry
+                }
+                settled[u] = 1;
+                if (u == target) {
+                    break;
+                }
+                long long base = distance[u];
+                adjacency.forEachOut(u, [&](std::size_t v, auto weight) {
+                    if (weight < 0) {
+                        negative = true;
+                    } else if (base + weight < distance[v]) {
+                        distance[v] = base + weight;
+                        parent[v] = static_cast<int>(u);
+                        push(v);
+                    }
+                });
+            }
+            return !negative;
+        }
+
+        /**
+         * @brief Write the path from the last run's source to target into out.
+         *
+         * @return False (with out cleared) if target was not reached.
+         */
+        bool pathTo(std::size_t target, Path& out) const {
+            out.vertices.clear();
+            out.cost = 0;
+            if (target >= distance.size() || distance[target] == UNREACHABLE) {
+                return false;
+            }
+            std::size_t length = 1;
+            for (std::size_t v = target; parent[v] != static_cast<int>(v); v = static_cast<std::size_t>(parent[v])) {
+                ++length;
+            }
+            out.vertices.resize(length);
+            std::size_t v = target;
+            for (std::size_t i = length; i-- > 0; v = static_cast<std::size_t>(parent[v])) {
+                out.vertices[i] = static_cast<int>(v);
+            }
+            out.cost = distance[target];
+            return true;
+        }
+
+    private:
+        HeapKind heapKind;
+        std::vector<char> settled;
+        RadixHeap radix;
+        DAryHeap dary;
+
+        void push(std::size_t v) {
+            if (heapKind == HeapKind::Radix) {
+                radix.push(static_cast<std::uint64_t>(distance[v]), v);
+            } else {
+                dary.pushOrDecrease(v, distance);
+            }
+        }
+
+        bool queueEmpty() const {
+            return heapKind == HeapKind::Radix ? radix.empty() : dary.empty();
+        }
+
+        // Next vertex to settle, or NO_TARGET for an outdated radix entry
+        std::size_t pop() {
+            if (heapKind == HeapKind::DAry) {
+                return dary.pop(distance);
+            }
+            auto [key, v] = radix.pop();
+            bool stale = settled[v] || static_cast<long long>(key) != distance[v];
+            return stale ? NO_TARGET : v;
+        }
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_DIJKSTRA_HPP
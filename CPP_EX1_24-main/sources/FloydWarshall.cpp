@@ -0,0 +1,148 @@
+#include "FloydWarshall.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace ariel {
+
+    namespace {
+        // Working sentinel for "no path". Sums of a finite distance and INF stay below
+        // LLONG_MAX, and anything above INF / 2 is still unreachable after negative edges.
+        constexpr long long INF = LLONG_MAX / 4;
+        // Floor that keeps distances on a negative cycle from overflowing before it is detected
+        constexpr long long FLOOR = -(LLONG_MAX / 4);
+
+        // Padded working matrix: stride is a whole number of tiles
+        struct Tiles {
+            std::size_t stride;
+            std::vector<long long> d;
+            std::vector<int> next;
+        };
+
+        // C = min(C, A + B) for tiles C = (ti, tj), A = (ti, tk), B = (tk, tj), with k outermost.
+        // k outermost keeps the update exact when C aliases A or B (diagonal, row and column
+        // phases), because each k step only reads row k and column k, which it does not change.
+        template <bool WithNext>
+        void relaxTile(Tiles& m, std::size_t ti, std::size_t tj, std::size_t tk) {
+            const std::size_t tile = FloydWarshall::TILE;
+            const std::size_t stride = m.stride;
+            for (std::size_t k = tk * tile; k < (tk + 1) * tile; ++k) {
+                const long long* rowK = m.d.data() + k * stride + tj * tile;
+                for (std::size_t i = ti * tile; i < (ti + 1) * tile; ++i) {
+                    long long a = m.d[i * stride + k];
+                    if (a > INF / 2) {
+                        continue; // No path i->k, nothing to relax
+                    }
+                    long long* rowI = m.d.data() + i * stride + tj * tile;
+                    if constexpr (WithNext) {
+                        int* nextI = m.next.data() + i * stride + tj * tile;
+                        int hop = m.next[i * stride + k];
+                        for (std::size_t j = 0; j < tile; ++j) {
+                            long long through = std::max(a + rowK[j], FLOOR);
+                            if (through < rowI[j]) {
+                                rowI[j] = through;
+                                nextI[j] = hop;
+                            }
+                        }
+                    } else {
+                        for (std::size_t j = 0; j < tile; ++j) {
+                            rowI[j] = std::min(rowI[j], std::max(a + rowK[j], FLOOR));
+                        }
+                    }
+                }
+            }
+        }
+
+        template <bool WithNext>
+        void solve(Tiles& m, std::size_t n) {
+            const std::size_t blocks = m.stride / FloydWarshall::TILE;
+            for (std::size_t k = 0; k < blocks; ++k) {
+                relaxTile<WithNext>(m, k, k, k);
+
+                // Row k and column k: 2 * (blocks - 1) tiles that only read the diagonal tile
+                parallelFor(2 * (blocks - 1), 1, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (std::size_t t = begin; t < end; ++t) {
+                        std::size_t other = t / 2 < k ? t / 2 : t / 2 + 1;
+                        if (t % 2 == 0) {
+                            relaxTile<WithNext>(m, k, other, k);
+                        } else {
+                            relaxTile<WithNext>(m, other, k, k);
+                        }
+                    }
+                });
+
+                // Every other tile reads only its row-k and column-k tiles
+                std::size_t rest = blocks - 1;
+                parallelFor(rest * rest, 1, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (std::size_t t = begin; t < end; ++t) {
+                        std::size_t i = t / rest < k ? t / rest : t / rest + 1;
+                        std::size_t j = t % rest < k ? t % rest : t % rest + 1;
+                        relaxTile<WithNext>(m, i, j, k);
+                    }
+                });
+
+                for (std::size_t v = 0; v < n; ++v) {
+                    if (m.d[v * m.stride + v] < 0) {
+                        throw std::invalid_argument("Graph contains a negative cycle");
+                    }
+                }
+            }
+        }
+    } // namespace
+
+    DistanceMatrix FloydWarshall::run(const Graph& graph, bool withNextHop) {
+        const std::vector<std::vector<int>>& rows = graph.getGraph();
+        std::size_t n = graph.vertices();
+        Tiles m;
+        m.stride = (n + TILE - 1) / TILE * TILE;
+        m.d.assign(m.stride * m.stride, INF);
+        if (withNextHop) {
+            m.next.assign(m.stride * m.stride, -1);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                if (rows[i][j] != 0) {
+                    m.d[i * m.stride + j] = rows[i][j];
+                    if (withNextHop) {
+                        m.next[i * m.stride + j] = static_cast<int>(j);
+                    }
+                }
+            }
+            // A negative self loop is a negative cycle by itself
+            m.d[i * m.stride + i] = std::min(0LL, m.d[i * m.stride + i]);
+            if (withNextHop && m.d[i * m.stride + i] == 0) {
+                m.next[i * m.stride + i] = static_cast<int>(i);
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            if (m.d[i * m.stride + i] < 0) {
+                throw std::invalid_argument("Graph contains a negative cycle");
+            }
+        }
+
+        if (withNextHop) {
+            solve<true>(m, n);
+        } else {
+            solve<false>(m, n);
+        }
+
+        DistanceMatrix result;
+        result.vertices = n;
+        result.distance.resize(n * n);
+        if (withNextHop) {
+            result.next.resize(n * n);
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t j = 0; j < n; ++j) {
+                long long d = m.d[i * m.stride + j];
+                result.distance[i * n + j] = d > INF / 2 ? DistanceMatrix::UNREACHABLE : d;
+                if (withNextHop) {
+                    result.next[i * n + j] = m.next[i * m.stride + j];
+                }
+            }
+        }
+        return result;
+    }
+
+} // namespace ariel
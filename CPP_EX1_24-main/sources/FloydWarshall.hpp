@@ -0,0 +1,39 @@
+#pragma once
+
+#include "Algorithms.hpp"
+#include "Graph.hpp"
+#include <cstddef>
+
+#ifndef CPP_EX4_FLOYDWARSHALL_HPP
+#define CPP_EX4_FLOYDWARSHALL_HPP
+
+namespace ariel {
+    /**
+     * @brief Blocked (tiled) Floyd-Warshall all-pairs shortest paths.
+     *
+     * The matrix is padded to whole TILE x TILE tiles. For every block k of intermediate
+     * vertices the diagonal tile is closed first, then the tiles in row k and column k
+     * (which only need the diagonal tile), then every remaining tile (which only needs its
+     * row-k and column-k tiles). Tiles within the last two phases are independent and are
+     * spread over the workers. The inner min-plus loop runs over contiguous rows without
+     * branches, so the compiler can vectorize it.
+     */
+    class FloydWarshall {
+    public:
+        // 128 x 128 distances of 8 bytes: the three tiles of a min-plus update (384 KiB)
+        // stay in a typical L2. Measured faster than 64 and 256 on 2048 vertices.
+        static constexpr std::size_t TILE = 128;
+
+        /**
+         * @brief Compute all-pairs distances.
+         *
+         * @param graph The graph; negative edges are allowed.
+         * @param withNextHop Also fill DistanceMatrix::next.
+         * @return The distance matrix.
+         * @throw std::invalid_argument If the graph contains a negative cycle.
+         */
+        static DistanceMatrix run(const Graph& graph, bool withNextHop);
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_FLOYDWARSHALL_HPP
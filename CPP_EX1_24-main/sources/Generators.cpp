@@ -0,0 +1,297 @@
+#include "Generators.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace ariel {
+
+    namespace {
+        // Edges handed to one worker at a time; small enough to balance, large enough
+        // that thread start-up is noise.
+        constexpr std::size_t EDGE_GRAIN = 1 << 16;
+        // Rows sorted per worker when finalizing a CSR index.
+        constexpr std::size_t ROW_GRAIN = 1 << 12;
+
+        constexpr std::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+        // SplitMix64 finalizer: a cheap bijective hash with good avalanche.
+        std::uint64_t mix(std::uint64_t x) {
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            return x ^ (x >> 31);
+        }
+
+        // Counter-based random source: the numbers drawn for edge k depend only on
+        // (seed, k), never on which thread generated the previous edges.
+        class EdgeRandom {
+        public:
+            EdgeRandom(std::uint64_t seed, std::size_t edge)
+                : state(mix(seed + GOLDEN_GAMMA) ^ mix(static_cast<std::uint64_t>(edge) * GOLDEN_GAMMA + 1)) {}
+
+            std::uint64_t next() {
+                state += GOLDEN_GAMMA;
+                return mix(state);
+            }
+
+            // Uniform in [0, 1) with 53 bits of precision
+            double unit() {
+                return static_cast<double>(next() >> 11) * 0x1.0p-53;
+            }
+
+            std::size_t below(std::size_t bound) {
+                return static_cast<std::size_t>(next() % bound);
+            }
+
+        private:
+            std::uint64_t state;
+        };
+
+        // Weight of u->v, derived from the endpoints so duplicate draws agree
+        int edgeWeight(std::uint64_t seed, std::size_t u, std::size_t v, int maxWeight) {
+            if (maxWeight <= 1) {
+                return 1;
+            }
+            std::uint64_t key = (static_cast<std::uint64_t>(u) << 32) ^ static_cast<std::uint64_t>(v);
+            std::uint64_t h = mix(mix(seed ^ GOLDEN_GAMMA) ^ key);
+            return 1 + static_cast<int>(h % static_cast<std::uint64_t>(maxWeight));
+        }
+
+        std::tuple<int, int, int> makeEdge(std::uint64_t seed, std::size_t u, std::size_t v, int maxWeight) {
+            return std::make_tuple(static_cast<int>(u), static_cast<int>(v), edgeWeight(seed, u, v, maxWeight));
+        }
+
+        void checkVertexCount(std::size_t n) {
+            if (n > static_cast<std::size_t>(INT_MAX)) {
+                throw std::invalid_argument("Too many vertices: vertex ids must fit in an int");
+            }
+        }
+
+        void checkWeight(int maxWeight) {
+            if (maxWeight < 1) {
+                throw std::invalid_argument("maxWeight must be at least 1");
+            }
+        }
+    } // namespace
+
+    EdgeStream Generators::erdosRenyi(std::size_t n, std::size_t m, std::uint64_t seed, int maxWeight) {
+        checkVertexCount(n);
+        checkWeight(maxWeight);
+        if (m > 0 && n < 2) {
+            throw std::invalid_argument("Erdos-Renyi needs at least two vertices to draw edges");
+        }
+        EdgeStream stream;
+        stream.numVertices = n;
+        stream.numEdges = m;
+        stream.edge = [n, seed, maxWeight](std::size_t k) {
+            EdgeRandom rng(seed, k);
+            std::size_t u = rng.below(n);
+            // Draw v from the other n - 1 vertices so there are no self loops
+            std::size_t v = rng.below(n - 1);
+            if (v >= u) {
+                ++v;
+            }
+            return makeEdge(seed, u, v, maxWeight);
+        };
+        return stream;
+    }
+
+    EdgeStream Generators::rmat(int scale, std::size_t edgeFactor, std::uint64_t seed,
+                                double a, double b, double c, int maxWeight) {
+        if (scale < 1 || scale > 30) {
+            throw std::invalid_argument("R-MAT scale must be between 1 and 30");
+        }
+        if (a < 0 || b < 0 || c < 0 || a + b + c > 1) {
+            throw std::invalid_argument("R-MAT quadrant probabilities must be non-negative and sum to at most 1");
+        }
+        checkWeight(maxWeight);
+        std::size_t n = std::size_t{1} << static_cast<unsigned>(scale);
+        std::uint64_t mask = static_cast<std::uint64_t>(n - 1);
+        // Odd multipliers and a right xorshift are both bijections modulo 2^scale
+        std::uint64_t mulA = mix(seed ^ 0xA5A5A5A5ULL) | 1;
+        std::uint64_t mulB = mix(seed ^ 0x5A5A5A5AULL) | 1;
+        unsigned shift = static_cast<unsigned>(scale / 2 + 1);
+        auto scramble = [mask, mulA, mulB, shift](std::uint64_t x) {
+            x = (x * mulA) & mask;
+            x ^= x >> shift;
+            return (x * mulB) & mask;
+        };
+
+        EdgeStream stream;
+        stream.numVertices = n;
+        stream.numEdges = edgeFactor * n;
+        double ab = a + b;
+        double abc = a + b + c;
+        stream.edge = [scale, seed, a, ab, abc, scramble, maxWeight](std::size_t k) {
+            EdgeRandom rng(seed, k);
+            std::uint64_t u = 0;
+            std::uint64_t v = 0;
+            for (int level = 0; level < scale; ++level) {
+                double r = rng.unit();
+                std::uint64_t bitU = r >= ab ? 1 : 0;
+                std::uint64_t bitV = (r >= a && r < ab) || r >= abc ? 1 : 0;
+                u = (u << 1) | bitU;
+                v = (v << 1) | bitV;
+            }
+            return makeEdge(seed, static_cast<std::size_t>(scramble(u)), static_cast<std::size_t>(scramble(v)),
+                            maxWeight);
+        };
+        return stream;
+    }
+
+    EdgeStream Generators::grid2D(std::size_t rows, std::size_t cols) {
+        checkVertexCount(rows * cols);
+        EdgeStream stream;
+        stream.numVertices = rows * cols;
+        if (rows == 0 || cols == 0) {
+            stream.edge = [](std::size_t) { return std::make_tuple(0, 0, 0); };
+            return stream;
+        }
+        std::size_t horizontal = rows * (cols - 1);
+        std::size_t vertical = (rows - 1) * cols;
+        stream.numEdges = 2 * (horizontal + vertical);
+        // Even k is the forward edge, odd k the same edge reversed
+        stream.edge = [cols, horizontal](std::size_t k) {
+            std::size_t pair = k / 2;
+            std::size_t from = 0;
+            std::size_t to = 0;
+            if (pair < horizontal) {
+                std::size_t r = pair / (cols - 1);
+                from = r * cols + pair % (cols - 1);
+                to = from + 1;
+            } else {
+                from = pair - horizontal;
+                to = from + cols;
+            }
+            if (k % 2 == 1) {
+                std::swap(from, to);
+            }
+            return std::make_tuple(static_cast<int>(from), static_cast<int>(to), 1);
+        };
+        return stream;
+    }
+
+    EdgeStream Generators::powerLaw(std::size_t n, std::size_t m, double exponent, std::uint64_t seed,
+                                    int maxWeight) {
+        checkVertexCount(n);
+        checkWeight(maxWeight);
+        if (exponent <= 1) {
+            throw std::invalid_argument("Power-law exponent must be greater than 1");
+        }
+        if (m > 0 && n < 2) {
+            throw std::invalid_argument("Power-law graph needs at least two vertices to draw edges");
+        }
+        // Chung-Lu: vertex i is drawn with probability proportional to (i + 1)^(-1 / (exponent - 1))
+        auto cdf = std::make_shared<std::vector<double>>(n);
+        double total = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            total += std::pow(static_cast<double>(i + 1), -1.0 / (exponent - 1));
+            (*cdf)[i] = total;
+        }
+
+        EdgeStream stream;
+        stream.numVertices = n;
+        stream.numEdges = m;
+        stream.edge = [n, seed, cdf, total, maxWeight](std::size_t k) {
+            EdgeRandom rng(seed, k);
+            auto draw = [&]() {
+                auto it = std::upper_bound(cdf->begin(), cdf->end(), rng.unit() * total);
+                return std::min(n - 1, static_cast<std::size_t>(it - cdf->begin()));
+            };
+            std::size_t u = draw();
+            std::size_t v = draw();
+            if (u == v) {
+                v = (v + 1) % n;
+            }
+            return makeEdge(seed, u, v, maxWeight);
+        };
+        return stream;
+    }
+
+    // Dense storage is bounded by n^2 memory anyway, so fill it in edge order on one thread
+    Graph Generators::toGraph(const EdgeStream& stream) {
+        std::vector<std::vector<int>> matrix(stream.numVertices, std::vector<int>(stream.numVertices, 0));
+        for (std::size_t k = 0; k < stream.numEdges; ++k) {
+            auto [u, v, weight] = stream.edge(k);
+            matrix[static_cast<std::size_t>(u)][static_cast<std::size_t>(v)] = weight;
+        }
+        Graph graph;
+        graph.loadGraph(matrix);
+        return graph;
+    }
+
+    // Two streaming passes (count, then scatter) so no edge list is ever materialized,
+    // followed by a per-row sort and dedup that makes the layout independent of the
+    // order in which the workers happened to scatter.
+    SparseIndex Generators::toSparse(const EdgeStream& stream) {
+        std::size_t n = stream.numVertices;
+        std::vector<std::atomic<std::size_t>> cursor(n);
+        for (auto& slot : cursor) {
+            slot.store(0, std::memory_order_relaxed);
+        }
+
+        parallelFor(stream.numEdges, EDGE_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t k = begin; k < end; ++k) {
+                auto edge = stream.edge(k);
+                cursor[static_cast<std::size_t>(std::get<0>(edge))].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+        std::vector<std::size_t> start(n + 1, 0);
+        for (std::size_t u = 0; u < n; ++u) {
+            start[u + 1] = start[u] + cursor[u].load(std::memory_order_relaxed);
+            cursor[u].store(start[u], std::memory_order_relaxed);
+        }
+
+        std::vector<int> targets(start[n]);
+        std::vector<int> weights(start[n]);
+        parallelFor(stream.numEdges, EDGE_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t k = begin; k < end; ++k) {
+                auto [u, v, weight] = stream.edge(k);
+                std::size_t slot = cursor[static_cast<std::size_t>(u)].fetch_add(1, std::memory_order_relaxed);
+                targets[slot] = v;
+                weights[slot] = weight;
+            }
+        });
+
+        std::vector<std::size_t> kept(n + 1, 0);
+        parallelFor(n, ROW_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+            std::vector<std::pair<int, int>> row;
+            for (std::size_t u = begin; u < end; ++u) {
+                row.clear();
+                for (std::size_t e = start[u]; e < start[u + 1]; ++e) {
+                    row.emplace_back(targets[e], weights[e]);
+                }
+                std::sort(row.begin(), row.end());
+                row.erase(std::unique(row.begin(), row.end()), row.end());
+                for (std::size_t i = 0; i < row.size(); ++i) {
+                    targets[start[u] + i] = row[i].first;
+                    weights[start[u] + i] = row[i].second;
+                }
+                kept[u + 1] = row.size();
+            }
+        });
+
+        SparseIndex index;
+        index.offsets.assign(n + 1, 0);
+        for (std::size_t u = 0; u < n; ++u) {
+            index.offsets[u + 1] = index.offsets[u] + kept[u + 1];
+        }
+        index.indices.resize(index.offsets[n]);
+        index.weights.resize(index.offsets[n]);
+        parallelFor(n, ROW_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t u = begin; u < end; ++u) {
+                std::copy_n(targets.begin() + static_cast<std::ptrdiff_t>(start[u]), kept[u + 1],
+                            index.indices.begin() + static_cast<std::ptrdiff_t>(index.offsets[u]));
+                std::copy_n(weights.begin() + static_cast<std::ptrdiff_t>(start[u]), kept[u + 1],
+                            index.weights.begin() + static_cast<std::ptrdiff_t>(index.offsets[u]));
+            }
+        });
+        return index;
+    }
+
+} // namespace ariel
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Graph.hpp"
+#include "SparseIndex.hpp"
+#include <cstdint>
+#include <functional>
+#include <tuple>
+
+#ifndef CPP_EX4_GENERATORS_HPP
+#define CPP_EX4_GENERATORS_HPP
+
+namespace ariel {
+    /**
+     * @brief A reproducible stream of edges.
+     *
+     * Edge k is a pure function of the generator seed and k, so the stream can be
+     * split across any number of threads and still yield exactly the same graph.
+     * Edges are (source, target, weight) tuples, as returned by Graph::edges().
+     */
+    struct EdgeStream {
+        std::size_t numVertices = 0;
+        std::size_t numEdges = 0;
+        std::function<std::tuple<int, int, int>(std::size_t)> edge;
+    };
+
+    /**
+     * @brief Seeded synthetic graph generators for scale testing.
+     *
+     * Generators only describe an EdgeStream; toGraph() and toSparse() consume it into
+     * dense or CSR storage. Weights are derived from the endpoints, so duplicate edges
+     * always carry the same weight and collapse to a single matrix entry.
+     */
+    class Generators {
+    public:
+        /**
+         * @brief Erdos-Renyi G(n, m): m edges with uniformly random endpoints, no self loops.
+         *
+         * @param n The number of vertices.
+         * @param m The number of edges to draw (duplicates collapse on load).
+         * @param seed The random seed.
+         * @param maxWeight Weights are drawn uniformly from [1, maxWeight].
+         * @return The edge stream.
+         * @throw std::invalid_argument If n < 2 while m > 0, or maxWeight < 1.
+         */
+        static EdgeStream erdosRenyi(std::size_t n, std::size_t m, std::uint64_t seed, int maxWeight = 1);
+
+        /**
+         * @brief R-MAT / Graph500 Kronecker generator with 2^scale vertices and edgeFactor * 2^scale edges.
+         *
+         * Vertex labels are scrambled with a bijection so high-degree vertices are not clustered at 0.
+         *
+         * @param scale log2 of the number of vertices.
+         * @param edgeFactor The average number of edges per vertex.
+         * @param seed The random seed.
+         * @param a,b,c Quadrant probabilities (d = 1 - a - b - c); defaults are the Graph500 ones.
+         * @param maxWeight Weights are drawn uniformly from [1, maxWeight].
+         * @return The edge stream.
+         * @throw std::invalid_argument If scale is outside [1, 30] or the probabilities are invalid.
+         */
+        static EdgeStream rmat(int scale, std::size_t edgeFactor, std::uint64_t seed,
+                               double a = 0.57, double b = 0.19, double c = 0.19, int maxWeight = 1);
+
+        /**
+         * @brief 2D grid with 4-neighborhood; every edge is emitted in both directions.
+         *
+         * @param rows The number of grid rows.
+         * @param cols The number of grid columns.
+         * @return The edge stream; vertex (r, c) has index r * cols + c.
+         */
+        static EdgeStream grid2D(std::size_t rows, std::size_t cols);
+
+        /**
+         * @brief Chung-Lu power-law graph whose expected degrees follow a power law.
+         *
+         * @param n The number of vertices.
+         * @param m The number of edges to draw.
+         * @param exponent The power-law exponent (must be greater than 1; typical graphs use 2-3).
+         * @param seed The random seed.
+         * @param maxWeight Weights are drawn uniformly from [1, maxWeight].
+         * @return The edge stream.
+         * @throw std::invalid_argument If exponent <= 1, or n < 2 while m > 0.
+         */
+        static EdgeStream powerLaw(std::size_t n, std::size_t m, double exponent, std::uint64_t seed,
+                                   int maxWeight = 1);
+
+        /**
+         * @brief Materialize a stream into a dense adjacency matrix.
+         *
+         * @param stream The edge stream.
+         * @return The graph.
+         */
+        static Graph toGraph(const EdgeStream& stream);
+
+        /**
+         * @brief Materialize a stream into a CSR index without building the dense matrix.
+         *
+         * Runs in parallel; rows are sorted and deduplicated, so the result is identical
+         * for any worker count and matches toGraph(stream).csr().
+         *
+         * @param stream The edge stream.
+         * @return The CSR index.
+         */
+        static SparseIndex toSparse(const EdgeStream& stream);
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_GENERATORS_HPP
@@ -1,13 +1,86 @@
 #include "Graph.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <unordered_set>
 #include <sstream> // For std::istringstream
+#include <limits>
 
 namespace ariel {
 
+    namespace {
+        // Blocks at or below this size are copied directly; a 16x16 tile of ints
+        // is 1 KiB per side, which stays resident in L1 on every target we build for.
+        constexpr std::size_t TRANSPOSE_LEAF = 16;
+
+        // Cache-oblivious transpose of src[row..row+rows)[col..col+cols) into dst.
+        // Splitting the longer side keeps the tiles square-ish at every level.
+        void transposeBlock(const std::vector<std::vector<int>>& src, std::vector<std::vector<int>>& dst,
+                            std::size_t row, std::size_t rows, std::size_t col, std::size_t cols) {
+            if (rows <= TRANSPOSE_LEAF && cols <= TRANSPOSE_LEAF) {
+                for (std::size_t i = row; i < row + rows; ++i) {
+                    const std::vector<int>& in = src[i];
+                    for (std::size_t j = col; j < col + cols; ++j) {
+                        dst[j][i] = in[j];
+                    }
+                }
+                return;
+            }
+            if (rows >= cols) {
+                std::size_t half = rows / 2;
+                transposeBlock(src, dst, row, half, col, cols);
+                transposeBlock(src, dst, row + half, rows - half, col, cols);
+            } else {
+                std::size_t half = cols / 2;
+                transposeBlock(src, dst, row, rows, col, half);
+                transposeBlock(src, dst, row, rows, col + half, cols - half);
+            }
+        }
+
+        // Aim for this many matrix cells per worker chunk in the dense products
+        constexpr std::size_t PRODUCT_GRAIN_CELLS = 1 << 16;
+
+        // Dot product of a matrix row with x. Four independent accumulators break the
+        // add dependency chain so the compiler can keep the loop in vector registers.
+        double dotRow(const std::vector<int>& row, const std::vector<double>& x) {
+            std::size_t n = row.size();
+            double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+            std::size_t j = 0;
+            for (; j + 4 <= n; j += 4) {
+                s0 += row[j] * x[j];
+                s1 += row[j + 1] * x[j + 1];
+                s2 += row[j + 2] * x[j + 2];
+                s3 += row[j + 3] * x[j + 3];
+            }
+            for (; j < n; ++j) {
+                s0 += row[j] * x[j];
+            }
+            return (s0 + s1) + (s2 + s3);
+        }
+
+        // y[begin..end) += scale * row[begin..end)
+        void axpyRow(double scale, const std::vector<int>& row, std::vector<double>& y,
+                     std::size_t begin, std::size_t end) {
+            for (std::size_t j = begin; j < end; ++j) {
+                y[j] += scale * row[j];
+            }
+        }
+
+        std::size_t rowsPerChunk(std::size_t n) {
+            return std::max<std::size_t>(1, PRODUCT_GRAIN_CELLS / std::max<std::size_t>(1, n));
+        }
+
+        std::size_t checkedVertex(int index, std::size_t n) {
+            if (index < 0 || static_cast<std::size_t>(index) >= n) {
+                throw std::out_of_range("Sparse vector index out of range");
+            }
+            return static_cast<std::size_t>(index);
+        }
+    } // namespace
+
     // Constructor definition without noexcept if it's not declared in the header
-    Graph::Graph() : numVertices(0), graph(), adjacency_matrix() {}
+    Graph::Graph() : numVertices(0), graph(), adjacency_matrix(), directed(false), declared(false) {}
 
     // Single implementation of loadGraph that checks if the matrix is square and then loads it.
     void Graph::loadGraph(const std::vector<std::vector<int>>& graph) {
@@ -20,6 +93,30 @@ namespace ariel {
         this->graph = graph;
         this->adjacency_matrix = graph;
         this->numVertices = graph.size();
+        this->directed = !isSymmetricMatrix(graph);
+        this->declared = false;
+    }
+
+    // Same as loadGraph(graph), but the caller states the direction instead of it being detected
+    void Graph::loadGraph(const std::vector<std::vector<int>>& graph, bool directed) {
+        if (!directed && isSquareMatrix(graph) && !isSymmetricMatrix(graph)) {
+            throw std::invalid_argument("Invalid graph: An undirected graph needs a symmetric matrix.");
+        }
+        loadGraph(graph);
+        this->directed = directed;
+        this->declared = true;
+    }
+
+    bool Graph::isDirected() const {
+        return directed;
+    }
+
+    // A declared directed operand keeps the result directed even when its matrix comes out
+    // symmetric; otherwise the direction is detected again from the new matrix
+    void Graph::combineDirection(const Graph& left, const Graph& right) {
+        bool keep = (left.declared && left.directed) || (right.declared && right.directed);
+        directed = keep || ((left.directed || right.directed) && !isSymmetricMatrix(graph));
+        declared = keep;
     }
 
     std::string Graph::printGraph() const {
@@ -87,6 +184,179 @@ namespace ariel {
         return edges().size();
     }
 
+    // Build the reverse graph with a recursive blocked transpose
+    Graph Graph::transpose() const {
+        std::vector<std::vector<int>> reversed(numVertices, std::vector<int>(numVertices, 0));
+        transposeBlock(graph, reversed, 0, numVertices, 0, numVertices);
+        Graph result;
+        if (declared) {
+            result.loadGraph(reversed, directed);
+        } else {
+            result.loadGraph(reversed);
+        }
+        return result;
+    }
+
+    // Each row of the product is a run of scaled copies of one row of `other`
+    Graph Graph::kronecker(const Graph& other) const {
+        if (numVertices == 0 || other.numVertices == 0) {
+            throw std::logic_error("Attempted the Kronecker product of empty graphs");
+        }
+        std::size_t m = other.numVertices;
+        std::vector<std::vector<int>> product(numVertices * m, std::vector<int>(numVertices * m, 0));
+        for (std::size_t i = 0; i < numVertices; ++i) {
+            for (std::size_t j = 0; j < numVertices; ++j) {
+                long long scale = graph[i][j];
+                if (scale == 0) {
+                    continue;
+                }
+                for (std::size_t k = 0; k < m; ++k) {
+                    const std::vector<int>& in = other.graph[k];
+                    std::vector<int>& out = product[i * m + k];
+                    for (std::size_t l = 0; l < m; ++l) {
+                        long long value = scale * in[l];
+                        if (value > std::numeric_limits<int>::max() || value < std::numeric_limits<int>::min()) {
+                            throw std::overflow_error("Integer overflow in Kronecker product");
+                        }
+                        out[j * m + l] = static_cast<int>(value);
+                    }
+                }
+            }
+        }
+        Graph result;
+        result.loadGraph(product);
+        return result;
+    }
+
+    // Rows are independent, so workers take contiguous row blocks
+    std::vector<double> Graph::mxv(const std::vector<double>& x) const {
+        if (x.size() != numVertices) {
+            throw std::invalid_argument("Vector size must match the number of vertices");
+        }
+        std::vector<double> y(numVertices, 0.0);
+        parallelFor(numVertices, rowsPerChunk(numVertices), [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i) {
+                y[i] = dotRow(graph[i], x);
+            }
+        });
+        return y;
+    }
+
+    // Only the columns named by x are gathered from each row
+    std::vector<double> Graph::mxv(const SparseVector& x) const {
+        if (x.indices.size() != x.values.size()) {
+            throw std::invalid_argument("Sparse vector must have one value per index");
+        }
+        std::vector<std::size_t> columns;
+        columns.reserve(x.indices.size());
+        for (int index : x.indices) {
+            columns.push_back(checkedVertex(index, numVertices));
+        }
+        std::vector<double> y(numVertices, 0.0);
+        std::size_t grain = rowsPerChunk(std::max<std::size_t>(1, columns.size()));
+        parallelFor(numVertices, grain, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::vector<int>& row = graph[i];
+                double sum = 0.0;
+                for (std::size_t k = 0; k < columns.size(); ++k) {
+                    sum += row[columns[k]] * x.values[k];
+                }
+                y[i] = sum;
+            }
+        });
+        return y;
+    }
+
+    // Row-major axpy over the whole matrix; workers own disjoint column blocks of y,
+    // so there are no write conflicts and the summation order never changes.
+    std::vector<double> Graph::vxm(const std::vector<double>& x) const {
+        if (x.size() != numVertices) {
+            throw std::invalid_argument("Vector size must match the number of vertices");
+        }
+        std::vector<double> y(numVertices, 0.0);
+        parallelFor(numVertices, rowsPerChunk(numVertices), [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = 0; i < numVertices; ++i) {
+                if (x[i] != 0.0) {
+                    axpyRow(x[i], graph[i], y, begin, end);
+                }
+            }
+        });
+        return y;
+    }
+
+    std::vector<double> Graph::vxm(const SparseVector& x) const {
+        if (x.indices.size() != x.values.size()) {
+            throw std::invalid_argument("Sparse vector must have one value per index");
+        }
+        std::vector<std::size_t> rows;
+        rows.reserve(x.indices.size());
+        for (int index : x.indices) {
+            rows.push_back(checkedVertex(index, numVertices));
+        }
+        std::vector<double> y(numVertices, 0.0);
+        std::size_t grain = rowsPerChunk(std::max<std::size_t>(1, rows.size()));
+        parallelFor(numVertices, grain, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t k = 0; k < rows.size(); ++k) {
+                axpyRow(x.values[k], graph[rows[k]], y, begin, end);
+            }
+        });
+        return y;
+    }
+
+    TransposedView Graph::transposed() const {
+        return TransposedView(*this);
+    }
+
+    // Build the CSR index in a single row-major pass; rows come out sorted by column
+    SparseIndex Graph::csr() const {
+        SparseIndex index;
+        index.offsets.assign(numVertices + 1, 0);
+        for (std::size_t i = 0; i < numVertices; ++i) {
+            const std::vector<int>& row = graph[i];
+            for (std::size_t j = 0; j < numVertices; ++j) {
+                if (row[j] != 0) {
+                    index.indices.push_back(static_cast<int>(j));
+                    index.weights.push_back(row[j]);
+                }
+            }
+            index.offsets[i + 1] = index.indices.size();
+        }
+        return index;
+    }
+
+    // Build the CSC index without materializing the transpose: count entries per
+    // column, prefix-sum the counts, then scatter rows in increasing order so every
+    // column range comes out sorted by source vertex.
+    SparseIndex Graph::csc() const {
+        SparseIndex index;
+        index.offsets.assign(numVertices + 1, 0);
+        for (std::size_t i = 0; i < numVertices; ++i) {
+            const std::vector<int>& row = graph[i];
+            for (std::size_t j = 0; j < numVertices; ++j) {
+                if (row[j] != 0) {
+                    ++index.offsets[j + 1];
+                }
+            }
+        }
+        for (std::size_t j = 0; j < numVertices; ++j) {
+            index.offsets[j + 1] += index.offsets[j];
+        }
+        index.indices.resize(index.offsets[numVertices]);
+        index.weights.resize(index.offsets[numVertices]);
+        std::vector<std::size_t> cursor(index.offsets.begin(), index.offsets.end() - 1);
+        for (std::size_t i = 0; i < numVertices; ++i) {
+            const std::vector<int>& row = graph[i];
+            for (std::size_t j = 0; j < numVertices; ++j) {
+                if (row[j] != 0) {
+                    std::size_t slot = cursor[j]++;
+                    index.indices[slot] = static_cast<int>(i);
+                    index.weights[slot] = row[j];
+                }
+            }
+        }
+        return index;
+    }
+
     // Check if a given matrix is square (has the same number of rows and columns)
     bool Graph::isSquareMatrix(const std::vector<std::vector<int>>& matrix) const {
         size_t n = matrix.size();
@@ -95,6 +365,17 @@ namespace ariel {
         }
         return true;
     }
+    bool Graph::isSymmetricMatrix(const std::vector<std::vector<int>>& matrix) {
+        for (std::size_t i = 0; i < matrix.size(); ++i) {
+            for (std::size_t j = i + 1; j < matrix.size(); ++j) {
+                if (matrix[i][j] != matrix[j][i]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
     Graph Graph::operator+(const Graph& other) const {
         if (this->vertices() == 0 || other.vertices() == 0) {
             throw std::logic_error("Attempted to add empty graphs");
@@ -126,6 +407,8 @@ namespace ariel {
                 graph[i][j] += other.graph[i][j];
             }
         }
+        // Element-wise sums of symmetric matrices stay symmetric; anything else must be checked
+        combineDirection(*this, other);
 
         return *this;
     }
@@ -144,6 +427,7 @@ namespace ariel {
                 result.graph[i][j] = graph[i][j] - other.graph[i][j];
             }
         }
+        result.combineDirection(*this, other);
 
         return result;
     }
@@ -158,6 +442,7 @@ namespace ariel {
                 graph[i][j] -= other.graph[i][j];
             }
         }
+        combineDirection(*this, other);
 
         return *this;
     }
@@ -193,6 +478,7 @@ namespace ariel {
                 graph[i][j] *= other.graph[i][j];
             }
         }
+        combineDirection(*this, other);
 
         return *this;
     }
@@ -207,6 +493,8 @@ namespace ariel {
                 result.graph[i][j] = graph[i][j] * scalar;
             }
         }
+        result.directed = directed;
+        result.declared = declared;
 
         return result;
     }
@@ -235,6 +523,8 @@ namespace ariel {
                 result.graph[i][j] = graph[i][j] / scalar;
             }
         }
+        result.directed = directed;
+        result.declared = declared;
 
         return result;
     }
@@ -315,6 +605,8 @@ namespace ariel {
                 result.graph[i][j] = -graph[i][j];
             }
         }
+        result.directed = directed;
+        result.declared = declared;
 
         return result;
     }
@@ -351,6 +643,20 @@ namespace ariel {
         return temp;
     }
 
+    TransposedView::TransposedView(const Graph& graph) : graph(&graph) {}
+
+    std::size_t TransposedView::vertices() const {
+        return graph->vertices();
+    }
+
+    int TransposedView::weight(std::size_t from, std::size_t to) const {
+        return graph->getGraph()[to][from];
+    }
+
+    const Graph& TransposedView::base() const {
+        return *graph;
+    }
+
     std::ostream& operator<<(std::ostream& os, const Graph& graph) {
         for (std::size_t i = 0; i < graph.numVertices; ++i) {
             os << "[";
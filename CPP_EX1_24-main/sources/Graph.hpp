@@ -3,11 +3,14 @@
 #include <vector>
 #include <tuple> // For std::tuple
 #include <iostream> // For std::ostream and std::istream
+#include "SparseIndex.hpp"
 
 #ifndef CPP_EX4_GRAPH_HPP
 #define CPP_EX4_GRAPH_HPP
 
 namespace ariel {
+    class TransposedView; // Forward declaration
+
     /**
      * @brief Class representing a graph.
      */
@@ -26,6 +29,29 @@ namespace ariel {
         Graph();
         void loadGraph(const std::vector<std::vector<int>>& graph);
 
+        /**
+         * @brief Load the graph from an adjacency matrix with a declared direction.
+         *
+         * @param graph The adjacency matrix representing the graph.
+         * @param directed Whether the graph is directed. A directed graph may have a
+         *                 symmetric matrix (every edge has a reverse edge).
+         * @throw std::invalid_argument If the matrix is not square, or if the graph is
+         *                              declared undirected but the matrix is not symmetric.
+         */
+        void loadGraph(const std::vector<std::vector<int>>& graph, bool directed);
+
+        /**
+         * @brief Check whether the graph is directed.
+         *
+         * Declared by loadGraph(graph, directed) or, otherwise, detected once when the
+         * matrix is loaded: a graph is undirected iff its matrix is symmetric. Element-wise
+         * operators between graphs keep a declared direction and re-detect a detected one
+         * for their result.
+         *
+         * @return True if the graph is directed.
+         */
+        bool isDirected() const;
+
         std::string printGraph() const;
 
         /**
@@ -64,6 +90,89 @@ namespace ariel {
          * @return The total number of edges.
          */
         int countEdges() const;
+
+        /**
+         * @brief Build the transpose (reverse graph) of this graph.
+         *
+         * Uses a cache-oblivious recursive blocking so both matrices are walked
+         * in cache-sized tiles regardless of the graph size.
+         *
+         * @return A new graph with every edge u->v replaced by v->u.
+         */
+        Graph transpose() const;
+
+        /**
+         * @brief Get a lazy, read-only view of the transpose without copying the matrix.
+         *
+         * @return A view that must not outlive this graph.
+         */
+        TransposedView transposed() const;
+
+        /**
+         * @brief Build a compressed sparse row index (out-neighbors) of the graph.
+         *
+         * @return The CSR index.
+         */
+        SparseIndex csr() const;
+
+        /**
+         * @brief Build a compressed sparse column index (in-neighbors) of the graph.
+         *
+         * @return The CSC index.
+         */
+        SparseIndex csc() const;
+
+        /**
+         * @brief Compute the Kronecker (tensor) product of this graph with another.
+         *
+         * Vertex (i, k) of the product has index i * other.vertices() + k, and the edge
+         * (i, k)->(j, l) has weight this(i, j) * other(k, l).
+         *
+         * @param other The right-hand factor.
+         * @return The product graph with vertices() * other.vertices() vertices.
+         * @throw std::logic_error If either graph is empty.
+         * @throw std::overflow_error If a product weight does not fit in an int.
+         */
+        Graph kronecker(const Graph& other) const;
+
+        /**
+         * @brief Matrix-vector product y = A * x (y[i] = sum over j of weight(i, j) * x[j]).
+         *
+         * @param x The dense input vector, one value per vertex.
+         * @return The dense result vector.
+         * @throw std::invalid_argument If x does not have one entry per vertex.
+         */
+        std::vector<double> mxv(const std::vector<double>& x) const;
+
+        /**
+         * @brief Matrix-vector product y = A * x for a sparse x.
+         *
+         * @param x The sparse input vector.
+         * @return The dense result vector.
+         * @throw std::invalid_argument If x does not have one value per index.
+         * @throw std::out_of_range If an index of x is not a vertex.
+         */
+        std::vector<double> mxv(const SparseVector& x) const;
+
+        /**
+         * @brief Vector-matrix product y = x * A (y[j] = sum over i of x[i] * weight(i, j)).
+         *
+         * @param x The dense input vector, one value per vertex.
+         * @return The dense result vector.
+         * @throw std::invalid_argument If x does not have one entry per vertex.
+         */
+        std::vector<double> vxm(const std::vector<double>& x) const;
+
+        /**
+         * @brief Vector-matrix product y = x * A for a sparse x; only the rows x selects are read.
+         *
+         * @param x The sparse input vector.
+         * @return The dense result vector.
+         * @throw std::invalid_argument If x does not have one value per index.
+         * @throw std::out_of_range If an index of x is not a vertex.
+         */
+        std::vector<double> vxm(const SparseVector& x) const;
+
         Graph operator+(const Graph& other) const;
         Graph operator*(const Graph& other) const;
         // Operator overloads
@@ -104,6 +213,16 @@ namespace ariel {
         std::vector<std::vector<int>> graph; // Adjacency matrix
         std::size_t numVertices; // Number of vertices
         std::vector<std::vector<int>> adjacency_matrix;
+        bool directed; // See isDirected()
+        bool declared; // Whether directed came from loadGraph(graph, directed)
+
+        /**
+         * @brief Set the direction of this graph, whose matrix was just computed from two operands.
+         *
+         * @param left The left operand.
+         * @param right The right operand.
+         */
+        void combineDirection(const Graph& left, const Graph& right);
 
         /**
          * @brief Check if a given matrix is square (has the same number of rows and columns).
@@ -112,6 +231,55 @@ namespace ariel {
          * @return True if the matrix is square, false otherwise.
          */
         bool isSquareMatrix(const std::vector<std::vector<int>>& matrix) const;
+
+        /**
+         * @brief Check if a square matrix equals its transpose.
+         *
+         * @param matrix The matrix to check.
+         * @return True if the matrix is symmetric, false otherwise.
+         */
+        static bool isSymmetricMatrix(const std::vector<std::vector<int>>& matrix);
+    };
+
+    /**
+     * @brief Read-only transpose of a graph, created in O(1).
+     *
+     * Reading weight(u, v) returns the weight of the edge v->u in the underlying graph.
+     */
+    class TransposedView {
+    public:
+        /**
+         * @brief Create a view over a graph.
+         *
+         * @param graph The graph to view; it must outlive the view.
+         */
+        explicit TransposedView(const Graph& graph);
+
+        /**
+         * @brief Get the number of vertices in the viewed graph.
+         *
+         * @return The number of vertices.
+         */
+        std::size_t vertices() const;
+
+        /**
+         * @brief Get the weight of the edge from -> to in the transposed graph.
+         *
+         * @param from The source vertex in the transposed graph.
+         * @param to The target vertex in the transposed graph.
+         * @return The weight, or 0 if there is no edge.
+         */
+        int weight(std::size_t from, std::size_t to) const;
+
+        /**
+         * @brief Get the graph this view transposes.
+         *
+         * @return The underlying graph.
+         */
+        const Graph& base() const;
+
+    private:
+        const Graph* graph;
     };
 } // namespace ariel
 
@@ -0,0 +1,81 @@
+#include "Johnson.hpp"
+#include "BellmanFord.hpp"
+#include "Dijkstra.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace ariel {
+
+    namespace {
+        // The CSR structure of the graph with long long weights w + h[u] - h[v], which can
+        // exceed the int range of the original weights
+        class ReweightedAdjacency {
+        public:
+            ReweightedAdjacency(const SparseIndex& out, const std::vector<long long>& h) : out(out), weights(out.nonZeros()) {
+                for (std::size_t u = 0; u < out.vertices(); ++u) {
+                    for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                        weights[e] = out.weights[e] + h[u] - h[static_cast<std::size_t>(out.indices[e])];
+                    }
+                }
+            }
+
+            std::size_t vertices() const { return out.vertices(); }
+
+            template <typename Visit>
+            void forEachOut(std::size_t u, const Visit& visit) const {
+                for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                    visit(static_cast<std::size_t>(out.indices[e]), weights[e]);
+                }
+            }
+
+        private:
+            const SparseIndex& out;
+            std::vector<long long> weights;
+        };
+    } // namespace
+
+    // The shared engine relaxes from the virtual source and reports any negative cycle;
+    // its distances are the potentials. Large graphs take the parallel strategy, as in
+    // Algorithms::bellmanFord().
+    std::vector<long long> Johnson::potentials(const SparseIndex& out) {
+        bool parallel = workerCount() > 1 && out.nonZeros() >= BellmanFord::PARALLEL_MIN_EDGES;
+        BellmanFord engine(parallel ? BellmanFord::Strategy::Parallel : BellmanFord::Strategy::Queue);
+        if (!engine.runFromAll(out)) {
+            throw std::invalid_argument("Graph contains a negative cycle");
+        }
+        return std::move(engine.distance);
+    }
+
+    void Johnson::run(const SparseIndex& out, const RowSink& row) {
+        std::size_t n = out.vertices();
+        std::vector<long long> h = potentials(out);
+        ReweightedAdjacency adjacency(out, h);
+
+        std::size_t workers = workerCount();
+        std::size_t batch = std::min(n, workers * BATCH_ROWS_PER_WORKER);
+        std::vector<DijkstraEngine> engines(workers);
+        std::vector<long long> rows(batch * n);
+        for (std::size_t first = 0; first < n; first += batch) {
+            std::size_t count = std::min(batch, n - first);
+            parallelForDynamic(count, 1, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+                DijkstraEngine& engine = engines[worker];
+                for (std::size_t i = begin; i < end; ++i) {
+                    std::size_t source = first + i;
+                    engine.run(adjacency, source);
+                    long long* distance = rows.data() + i * n;
+                    for (std::size_t v = 0; v < n; ++v) {
+                        long long reweighted = engine.distance[v];
+                        distance[v] = reweighted == DijkstraEngine::UNREACHABLE ? DistanceMatrix::UNREACHABLE
+                                                                                : reweighted - h[source] + h[v];
+                    }
+                }
+            });
+            // Hand the batch over on this thread, so the sink needs no locking and may throw
+            for (std::size_t i = 0; i < count; ++i) {
+                row(first + i, std::span<const long long>(rows.data() + i * n, n));
+            }
+        }
+    }
+} // namespace ariel
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Algorithms.hpp"
+#include "SparseIndex.hpp"
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+#ifndef CPP_EX4_JOHNSON_HPP
+#define CPP_EX4_JOHNSON_HPP
+
+namespace ariel {
+    /**
+     * @brief Johnson's all-pairs shortest paths for sparse graphs with negative edges.
+     *
+     * Bellman-Ford (the shared BellmanFord engine) from a virtual source joined to every
+     * vertex by a zero edge yields potentials h with h[v] <= h[u] + w(u, v), or finds a
+     * negative cycle. Every edge is then reweighted to w(u, v) + h[u] - h[v] >= 0 and one Dijkstra
+     * per source runs on the result, O(V E log V) in total instead of Floyd-Warshall's V^3.
+     *
+     * Rows are produced in batches of BATCH_ROWS_PER_WORKER rows per worker and handed to
+     * the caller in source order, so only one batch of rows is held in memory at a time.
+     */
+    class Johnson {
+    public:
+        // Receives row source: the distance from source to every vertex,
+        // DistanceMatrix::UNREACHABLE where there is no path. The span is only valid during
+        // the call.
+        using RowSink = std::function<void(std::size_t source, std::span<const long long> distance)>;
+
+        // Sources per worker in one batch: enough to amortize the fork/join, few enough
+        // that a batch of rows stays small next to the graph
+        static constexpr std::size_t BATCH_ROWS_PER_WORKER = 4;
+
+        /**
+         * @brief Compute the Bellman-Ford potentials from the virtual source.
+         *
+         * @param out The CSR index of the graph.
+         * @return h[v] <= 0 for every vertex, with h[v] <= h[u] + w(u, v) for every edge.
+         * @throw std::invalid_argument If the graph contains a negative cycle.
+         */
+        static std::vector<long long> potentials(const SparseIndex& out);
+
+        /**
+         * @brief Compute all-pairs distances and stream them row by row.
+         *
+         * @param out The CSR index of the graph; negative edges are allowed.
+         * @param row Called once per source, in increasing order, on the calling thread.
+         * @throw std::invalid_argument If the graph contains a negative cycle (before any row).
+         */
+        static void run(const SparseIndex& out, const RowSink& row);
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_JOHNSON_HPP
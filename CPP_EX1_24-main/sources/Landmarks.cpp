@@ -0,0 +1,351 @@
+#include "Landmarks.hpp"
+#include "BFSEngine.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace ariel {
+
+    namespace {
+        constexpr std::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+        // SplitMix64 finalizer, so root i depends only on (seed, i)
+        std::uint64_t mix(std::uint64_t x) {
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            return x ^ (x >> 31);
+        }
+
+        std::size_t checkedVertex(int vertex, std::size_t numVertices) {
+            if (vertex < 0 || static_cast<std::size_t>(vertex) >= numVertices) {
+                throw std::out_of_range("Vertex index out of range");
+            }
+            return static_cast<std::size_t>(vertex);
+        }
+
+        void runOrThrow(DijkstraEngine& engine, const SparseAdjacency& adjacency, std::size_t source) {
+            if (!engine.run(adjacency, source)) {
+                throw std::invalid_argument("Landmark distances require non-negative edge weights");
+            }
+        }
+    } // namespace
+
+    LandmarkIndex::LandmarkIndex(const Graph& graph, std::size_t count, Selection selection, std::uint64_t seed) {
+        build(graph.csr(), graph.csc(), count, selection, seed);
+    }
+
+    LandmarkIndex::LandmarkIndex(const SparseIndex& out, const SparseIndex& in, std::size_t count,
+                                 Selection selection, std::uint64_t seed) {
+        build(out, in, count, selection, seed);
+    }
+
+    std::size_t LandmarkIndex::vertices() const {
+        return numVertices;
+    }
+
+    const std::vector<int>& LandmarkIndex::landmarks() const {
+        return chosen;
+    }
+
+    // Every landmark gives two bounds; a bound needs both of its distances to be finite.
+    long long LandmarkIndex::lowerBound(std::size_t from, std::size_t to) const {
+        std::size_t k = chosen.size();
+        const long long* fromSource = fromLandmark.data() + from * k;
+        const long long* fromTarget = fromLandmark.data() + to * k;
+        const long long* toSource = toLandmark.data() + from * k;
+        const long long* toTarget = toLandmark.data() + to * k;
+        long long bound = 0;
+        for (std::size_t i = 0; i < k; ++i) {
+            if (fromSource[i] != UNREACHABLE && fromTarget[i] != UNREACHABLE) {
+                bound = std::max(bound, fromTarget[i] - fromSource[i]);
+            }
+            if (toSource[i] != UNREACHABLE && toTarget[i] != UNREACHABLE) {
+                bound = std::max(bound, toSource[i] - toTarget[i]);
+            }
+        }
+        return bound;
+    }
+
+    // Each round draws a random root and asks the heuristic for the next landmark, then runs
+    // a forward and a backward Dijkstra from the landmark to fill its table columns.
+    void LandmarkIndex::build(const SparseIndex& out, const SparseIndex& in, std::size_t count,
+                              Selection selection, std::uint64_t seed) {
+        if (out.vertices() != in.vertices()) {
+            throw std::invalid_argument("CSR and CSC indexes must cover the same vertices");
+        }
+        numVertices = out.vertices();
+        chosen.clear();
+        fromLandmark.clear();
+        toLandmark.clear();
+        count = std::min(count, numVertices);
+
+        SparseAdjacency forward(out, in);
+        SparseAdjacency backward(in, out); // Out-edges of the transpose are the in-edges
+        DijkstraEngine fromEngine;
+        DijkstraEngine toEngine;
+        for (std::size_t i = 0; i < count; ++i) {
+            // Farthest only needs a root for its first landmark
+            std::size_t root = static_cast<std::size_t>(mix(seed + i * GOLDEN_GAMMA) % numVertices);
+            if (selection == Selection::Avoid || i == 0) {
+                runOrThrow(fromEngine, forward, root);
+            }
+            std::size_t landmark = selection == Selection::Farthest
+                                       ? farthestVertex(fromEngine.distance)
+                                       : avoidVertex(root, fromEngine.distance, fromEngine.parent);
+            runOrThrow(fromEngine, forward, landmark);
+            runOrThrow(toEngine, backward, landmark);
+            addLandmark(landmark, fromEngine.distance, toEngine.distance);
+        }
+    }
+
+    // Widen both tables by one column; the k * n copy is small next to the two searches
+    void LandmarkIndex::addLandmark(std::size_t landmark, const std::vector<long long>& from,
+                                    const std::vector<long long>& to) {
+        std::size_t k = chosen.size();
+        std::vector<long long> widerFrom(numVertices * (k + 1));
+        std::vector<long long> widerTo(numVertices * (k + 1));
+        for (std::size_t v = 0; v < numVertices; ++v) {
+            for (std::size_t i = 0; i < k; ++i) {
+                widerFrom[v * (k + 1) + i] = fromLandmark[v * k + i];
+                widerTo[v * (k + 1) + i] = toLandmark[v * k + i];
+            }
+            widerFrom[v * (k + 1) + k] = from[v];
+            widerTo[v * (k + 1) + k] = to[v];
+        }
+        fromLandmark.swap(widerFrom);
+        toLandmark.swap(widerTo);
+        chosen.push_back(static_cast<int>(landmark));
+    }
+
+    // The first landmark is the vertex farthest from the root; later ones maximize the
+    // distance from the nearest landmark. Unreachable vertices count as farthest, so every
+    // part of a disconnected graph eventually gets a landmark.
+    std::size_t LandmarkIndex::farthestVertex(const std::vector<long long>& rootDistance) const {
+        std::size_t k = chosen.size();
+        std::size_t best = 0;
+        long long bestScore = -1;
+        for (std::size_t v = 0; v < numVertices; ++v) {
+            if (std::find(chosen.begin(), chosen.end(), static_cast<int>(v)) != chosen.end()) {
+                continue;
+            }
+            long long score = k == 0 ? rootDistance[v] : UNREACHABLE;
+            for (std::size_t i = 0; i < k; ++i) {
+                score = std::min(score, fromLandmark[v * k + i]);
+            }
+            if (score > bestScore) {
+                bestScore = score;
+                best = v;
+            }
+        }
+        return best;
+    }
+
+    // Avoid (Goldberg and Werneck): weigh every vertex of the root's shortest-path tree by how
+    // far its distance exceeds the current lower bound, sum the weights per subtree, drop
+    // subtrees that already hold a landmark, and walk from the root into the heaviest child
+    // until no child carries weight.
+    std::size_t LandmarkIndex::avoidVertex(std::size_t root, const std::vector<long long>& rootDistance,
+                                           const std::vector<int>& rootParent) const {
+        std::vector<std::size_t> childStart(numVertices + 1, 0);
+        for (std::size_t v = 0; v < numVertices; ++v) {
+            if (v != root && rootParent[v] != -1) {
+                ++childStart[static_cast<std::size_t>(rootParent[v]) + 1];
+            }
+        }
+        for (std::size_t v = 0; v < numVertices; ++v) {
+            childStart[v + 1] += childStart[v];
+        }
+        std::vector<std::size_t> children(childStart[numVertices]);
+        std::vector<std::size_t> fill(childStart.begin(), childStart.end() - 1);
+        for (std::size_t v = 0; v < numVertices; ++v) {
+            if (v != root && rootParent[v] != -1) {
+                children[fill[static_cast<std::size_t>(rootParent[v])]++] = v;
+            }
+        }
+
+        // Tree order from the root; walked backwards it visits children before parents
+        std::vector<std::size_t> order(1, root);
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            for (std::size_t c = childStart[order[i]]; c < childStart[order[i] + 1]; ++c) {
+                order.push_back(children[c]);
+            }
+        }
+        std::vector<long long> size(numVertices, 0);
+        for (std::size_t i = order.size(); i-- > 0;) {
+            std::size_t v = order[i];
+            if (std::find(chosen.begin(), chosen.end(), static_cast<int>(v)) != chosen.end()) {
+                size[v] = -1; // Covered: a landmark lies in this subtree
+                continue;
+            }
+            long long total = rootDistance[v] - lowerBound(root, v);
+            for (std::size_t c = childStart[v]; c < childStart[v + 1] && total >= 0; ++c) {
+                total = size[children[c]] < 0 ? -1 : total + size[children[c]];
+            }
+            size[v] = total;
+        }
+        if (size[root] <= 0) {
+            return farthestVertex(rootDistance);
+        }
+
+        std::size_t v = root;
+        for (;;) {
+            std::size_t heaviest = v;
+            long long heaviestSize = 0;
+            for (std::size_t c = childStart[v]; c < childStart[v + 1]; ++c) {
+                if (size[children[c]] > heaviestSize) {
+                    heaviestSize = size[children[c]];
+                    heaviest = children[c];
+                }
+            }
+            if (heaviest == v) {
+                return v;
+            }
+            v = heaviest;
+        }
+    }
+
+    bool LandmarkIndex::query(const Graph& graph, int src, int dest, Path& out) {
+        if (graph.vertices() != numVertices) {
+            throw std::invalid_argument("Graph size does not match the landmark index");
+        }
+        return search(DenseAdjacency(graph), checkedVertex(src, numVertices), checkedVertex(dest, numVertices), out);
+    }
+
+    bool LandmarkIndex::query(const SparseIndex& index, int src, int dest, Path& out) {
+        if (index.vertices() != numVertices) {
+            throw std::invalid_argument("Index size does not match the landmark index");
+        }
+        // Only out-edges are walked, so the CSR can stand in for the unused CSC
+        return search(SparseAdjacency(index, index), checkedVertex(src, numVertices),
+                      checkedVertex(dest, numVertices), out);
+    }
+
+    // A* keyed on distance + lower bound. A vertex whose distance drops after it was settled
+    // is queued again, so the search stays exact even where a missing landmark distance makes
+    // the bound inconsistent along an edge.
+    template <typename Adjacency>
+    bool LandmarkIndex::search(const Adjacency& adjacency, std::size_t source, std::size_t target, Path& out) {
+        out.vertices.clear();
+        out.cost = 0;
+        distance.assign(numVertices, UNREACHABLE);
+        estimate.assign(numVertices, UNREACHABLE);
+        parent.assign(numVertices, -1);
+        heap.reset(numVertices);
+        explored = 0;
+
+        distance[source] = 0;
+        parent[source] = static_cast<int>(source);
+        estimate[source] = lowerBound(source, target);
+        heap.pushOrDecrease(source, estimate);
+        while (!heap.empty()) {
+            std::size_t u = heap.pop(estimate);
+            ++explored;
+            if (u == target) {
+                break;
+            }
+            long long base = distance[u];
+            adjacency.forEachOut(u, [&](std::size_t v, int weight) {
+                long long candidate = base + weight;
+                if (candidate < distance[v]) {
+                    distance[v] = candidate;
+                    parent[v] = static_cast<int>(u);
+                    estimate[v] = candidate + lowerBound(v, target);
+                    heap.pushOrDecrease(v, estimate);
+                }
+            });
+        }
+
+        if (distance[target] == UNREACHABLE) {
+            return false;
+        }
+        for (std::size_t v = target;; v = static_cast<std::size_t>(parent[v])) {
+            out.vertices.push_back(static_cast<int>(v));
+            if (parent[v] == static_cast<int>(v)) {
+                break;
+            }
+        }
+        std::reverse(out.vertices.begin(), out.vertices.end());
+        out.cost = distance[target];
+        return true;
+    }
+
+    std::ostream& operator<<(std::ostream& os, const LandmarkIndex& index) {
+        std::size_t k = index.chosen.size();
+        auto write = [&os](long long value) {
+            os << ' ' << (value == LandmarkIndex::UNREACHABLE ? -1 : value);
+        };
+        os << "ALT 1\n" << index.numVertices << ' ' << k << '\n';
+        for (std::size_t i = 0; i < k; ++i) {
+            os << (i > 0 ? " " : "") << index.chosen[i];
+        }
+        os << '\n';
+        for (std::size_t v = 0; v < index.numVertices; ++v) {
+            os << v << ':';
+            for (std::size_t i = 0; i < k; ++i) {
+                write(index.fromLandmark[v * k + i]);
+            }
+            for (std::size_t i = 0; i < k; ++i) {
+                write(index.toLandmark[v * k + i]);
+            }
+            os << '\n';
+        }
+        return os;
+    }
+
+    // Nothing is sized from the header alone: the tables grow as rows arrive, so a header
+    // promising more than the stream holds fails on the first missing value
+    std::istream& operator>>(std::istream& is, LandmarkIndex& index) {
+        std::string magic;
+        int version = 0;
+        std::size_t n = 0;
+        std::size_t k = 0;
+        if (!(is >> magic >> version >> n >> k) || magic != "ALT" || version != 1 || k > n) {
+            throw std::invalid_argument("Invalid input: not a landmark table.");
+        }
+        std::vector<long long> from;
+        std::vector<long long> to;
+        if ((n > 0 && k == 0) || (k > 0 && n > from.max_size() / k)) {
+            throw std::invalid_argument("Invalid input: bad landmark count.");
+        }
+        std::vector<int> chosen;
+        for (std::size_t i = 0; i < k; ++i) {
+            int landmark = 0;
+            if (!(is >> landmark) || landmark < 0 || static_cast<std::size_t>(landmark) >= n) {
+                throw std::invalid_argument("Invalid input: bad landmark vertex.");
+            }
+            chosen.push_back(landmark);
+        }
+        auto read = [&is](std::vector<long long>& table) {
+            long long value = 0;
+            if (!(is >> value) || value < -1) {
+                throw std::invalid_argument("Invalid input: bad landmark distance.");
+            }
+            table.push_back(value == -1 ? LandmarkIndex::UNREACHABLE : value);
+        };
+        for (std::size_t v = 0; v < n; ++v) {
+            std::size_t label = 0;
+            char colon = 0;
+            if (!(is >> label >> colon) || label != v || colon != ':') {
+                throw std::invalid_argument("Invalid input: landmark table rows out of order.");
+            }
+            for (std::size_t i = 0; i < k; ++i) {
+                read(from);
+            }
+            for (std::size_t i = 0; i < k; ++i) {
+                read(to);
+            }
+        }
+        for (std::size_t i = 0; i < k; ++i) {
+            std::size_t self = static_cast<std::size_t>(chosen[i]) * k + i;
+            if (from[self] != 0 || to[self] != 0) {
+                throw std::invalid_argument("Invalid input: a landmark is not at distance 0 from itself.");
+            }
+        }
+        index.numVertices = n;
+        index.chosen.swap(chosen);
+        index.fromLandmark.swap(from);
+        index.toLandmark.swap(to);
+        return is;
+    }
+
+} // namespace ariel
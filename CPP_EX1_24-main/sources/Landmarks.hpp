@@ -0,0 +1,149 @@
+#pragma once
+
+#include "Dijkstra.hpp"
+#include "Graph.hpp"
+#include "SparseIndex.hpp"
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+#ifndef CPP_EX4_LANDMARKS_HPP
+#define CPP_EX4_LANDMARKS_HPP
+
+namespace ariel {
+    /**
+     * @brief ALT index: A* search with landmark distance tables as lower bounds.
+     *
+     * Preprocessing picks a few landmarks and stores the distance from every landmark to
+     * every vertex and from every vertex to every landmark. By the triangle inequality
+     * d(L, t) - d(L, v) and d(v, L) - d(t, L) never exceed d(v, t), so their maximum over the
+     * landmarks steers an A* query towards dest. The tables are stored vertex-major, so a
+     * lower bound reads one contiguous run per vertex.
+     *
+     * The tables can be written with operator<< and read back with operator>>, so the
+     * preprocessing can be done once and the index loaded next to the same graph later.
+     */
+    class LandmarkIndex {
+    public:
+        enum class Selection {
+            Farthest, // Each landmark is the vertex farthest from the landmarks chosen so far
+            Avoid     // Each landmark sits in the subtree whose distances the current bounds cover worst
+        };
+
+        static constexpr long long UNREACHABLE = LLONG_MAX;
+
+        std::size_t explored = 0; // Vertices settled by the last query
+
+        /**
+         * @brief Empty index, to be filled by operator>>.
+         */
+        LandmarkIndex() = default;
+
+        /**
+         * @brief Select landmarks in a graph and compute their distance tables.
+         *
+         * @param graph The graph; weights must be non-negative.
+         * @param count The number of landmarks (capped at the number of vertices).
+         * @param selection The landmark selection heuristic.
+         * @param seed Picks the random roots the heuristics start from.
+         * @throw std::invalid_argument If the graph has a negative edge.
+         */
+        LandmarkIndex(const Graph& graph, std::size_t count, Selection selection = Selection::Avoid,
+                      std::uint64_t seed = 1);
+
+        /**
+         * @brief Select landmarks from CSR and CSC indexes of a graph.
+         *
+         * @param out The CSR index of the graph (see Graph::csr()).
+         * @param in The CSC index of the same graph (see Graph::csc()).
+         * @param count The number of landmarks (capped at the number of vertices).
+         * @param selection The landmark selection heuristic.
+         * @param seed Picks the random roots the heuristics start from.
+         * @throw std::invalid_argument If the graph has a negative edge or the indexes differ in size.
+         */
+        LandmarkIndex(const SparseIndex& out, const SparseIndex& in, std::size_t count,
+                      Selection selection = Selection::Avoid, std::uint64_t seed = 1);
+
+        /**
+         * @brief Get the number of vertices the tables cover.
+         *
+         * @return The number of vertices.
+         */
+        std::size_t vertices() const;
+
+        /**
+         * @brief Get the selected landmarks, in selection order.
+         *
+         * @return The landmark vertices.
+         */
+        const std::vector<int>& landmarks() const;
+
+        /**
+         * @brief Lower bound on the distance from one vertex to another.
+         *
+         * @param from The start vertex.
+         * @param to The end vertex.
+         * @return A value no larger than d(from, to); 0 if no landmark gives a bound.
+         */
+        long long lowerBound(std::size_t from, std::size_t to) const;
+
+        /**
+         * @brief Find the lightest path with landmark-guided A*.
+         *
+         * @param graph The graph the index was built for.
+         * @param src The source vertex.
+         * @param dest The destination vertex.
+         * @param out Receives the path and its cost; its buffer is reused.
+         * @return True if dest is reachable from src.
+         * @throw std::out_of_range If src or dest is not a vertex of the graph.
+         * @throw std::invalid_argument If the graph size does not match the index.
+         */
+        bool query(const Graph& graph, int src, int dest, Path& out);
+
+        /**
+         * @brief Find the lightest path with landmark-guided A* over a CSR index.
+         *
+         * @param index The CSR index of the graph the landmarks were built for.
+         * @param src The source vertex.
+         * @param dest The destination vertex.
+         * @param out Receives the path and its cost; its buffer is reused.
+         * @return True if dest is reachable from src.
+         * @throw std::out_of_range If src or dest is not a vertex of the graph.
+         * @throw std::invalid_argument If the index size does not match.
+         */
+        bool query(const SparseIndex& index, int src, int dest, Path& out);
+
+        // Text format: "ALT 1", then "<vertices> <landmarks>", the landmarks, and one line per
+        // vertex with its distances from and then to each landmark (-1 for unreachable).
+        // Reading throws std::invalid_argument on malformed text, on a table without
+        // landmarks, and on a landmark whose distance to itself is not 0.
+        friend std::ostream& operator<<(std::ostream& os, const LandmarkIndex& index);
+        friend std::istream& operator>>(std::istream& is, LandmarkIndex& index);
+
+    private:
+        std::size_t numVertices = 0;
+        std::vector<int> chosen;
+        std::vector<long long> fromLandmark; // [v * landmarks + i] = d(landmark i, v)
+        std::vector<long long> toLandmark;   // [v * landmarks + i] = d(v, landmark i)
+
+        // Query workspace, kept between queries
+        std::vector<long long> distance;
+        std::vector<long long> estimate; // distance + lowerBound to dest, the A* key
+        std::vector<int> parent;
+        DAryHeap heap;
+
+        void build(const SparseIndex& out, const SparseIndex& in, std::size_t count, Selection selection,
+                   std::uint64_t seed);
+        void addLandmark(std::size_t landmark, const std::vector<long long>& from, const std::vector<long long>& to);
+        std::size_t farthestVertex(const std::vector<long long>& rootDistance) const;
+        std::size_t avoidVertex(std::size_t root, const std::vector<long long>& rootDistance,
+                                const std::vector<int>& rootParent) const;
+
+        template <typename Adjacency>
+        bool search(const Adjacency& adjacency, std::size_t source, std::size_t target, Path& out);
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_LANDMARKS_HPP
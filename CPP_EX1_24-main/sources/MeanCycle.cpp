@@ -0,0 +1,281 @@
+#include "MeanCycle.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+namespace ariel {
+
+    namespace {
+        constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+        // Howard iterations before falling back to Karp. Policy iteration normally settles
+        // in a few dozen; the cap only guards against cycling between equal-mean policies.
+        constexpr std::size_t HOWARD_MIN_ITERATIONS = 256;
+
+        int edgeWeight(const SparseIndex& out, std::size_t from, std::size_t to) {
+            auto first = out.indices.begin() + static_cast<std::ptrdiff_t>(out.offsets[from]);
+            auto last = out.indices.begin() + static_cast<std::ptrdiff_t>(out.offsets[from + 1]);
+            auto it = std::lower_bound(first, last, static_cast<int>(to));
+            return out.weights[static_cast<std::size_t>(it - out.indices.begin())];
+        }
+
+        MeanCycle makeCycle(const SparseIndex& out, std::vector<int> vertices) {
+            MeanCycle result;
+            for (std::size_t i = 0; i < vertices.size(); ++i) {
+                std::size_t from = static_cast<std::size_t>(vertices[i]);
+                std::size_t to = static_cast<std::size_t>(vertices[(i + 1) % vertices.size()]);
+                result.weight += edgeWeight(out, from, to);
+            }
+            long long length = static_cast<long long>(vertices.size());
+            long long divisor = std::gcd(std::llabs(result.weight), length);
+            result.numerator = result.weight / divisor;
+            result.denominator = length / divisor;
+            result.vertices = std::move(vertices);
+            return result;
+        }
+
+        // a/b < c/d for positive denominators
+        bool lessRatio(long long a, long long b, long long c, long long d) {
+            return a * d < c * b;
+        }
+    } // namespace
+
+    std::optional<MeanCycle> MinimumMeanCycle::karp(const SparseIndex& out) {
+        std::size_t n = out.vertices();
+        const long long unreached = LLONG_MAX;
+        // Row k holds D[k]; parent[k * n + v] is the vertex before v on that walk
+        std::vector<long long> walk((n + 1) * n, unreached);
+        std::vector<int> parent((n + 1) * n, -1);
+        std::fill(walk.begin(), walk.begin() + static_cast<std::ptrdiff_t>(n), 0);
+        for (std::size_t k = 1; k <= n; ++k) {
+            const long long* previous = walk.data() + (k - 1) * n;
+            long long* current = walk.data() + k * n;
+            for (std::size_t u = 0; u < n; ++u) {
+                if (previous[u] == unreached) {
+                    continue;
+                }
+                for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                    std::size_t v = static_cast<std::size_t>(out.indices[e]);
+                    if (previous[u] + out.weights[e] < current[v]) {
+                        current[v] = previous[u] + out.weights[e];
+                        parent[k * n + v] = static_cast<int>(u);
+                    }
+                }
+            }
+        }
+
+        std::size_t best = NONE;
+        long long bestNumerator = 0;
+        long long bestDenominator = 1;
+        const long long* last = walk.data() + n * n;
+        for (std::size_t v = 0; v < n; ++v) {
+            if (last[v] == unreached) {
+                continue;
+            }
+            // D[0][v] = 0, so the maximum always has a candidate
+            long long numerator = last[v];
+            long long denominator = static_cast<long long>(n);
+            for (std::size_t k = 1; k < n; ++k) {
+                long long dk = walk[k * n + v];
+                if (dk != unreached && lessRatio(numerator, denominator, last[v] - dk, static_cast<long long>(n - k))) {
+                    numerator = last[v] - dk;
+                    denominator = static_cast<long long>(n - k);
+                }
+            }
+            if (best == NONE || lessRatio(numerator, denominator, bestNumerator, bestDenominator)) {
+                best = v;
+                bestNumerator = numerator;
+                bestDenominator = denominator;
+            }
+        }
+        if (best == NONE) {
+            return std::nullopt; // No walk of n edges: the graph is acyclic
+        }
+
+        // Every cycle on the n-edge walk to best has the minimum mean; take the first repeat
+        std::vector<std::size_t> path(n + 1);
+        path[n] = best;
+        for (std::size_t k = n; k > 0; --k) {
+            path[k - 1] = static_cast<std::size_t>(parent[k * n + path[k]]);
+        }
+        std::vector<std::size_t> seenAt(n, NONE);
+        for (std::size_t i = 0; i <= n; ++i) {
+            if (seenAt[path[i]] != NONE) {
+                std::vector<int> cycle;
+                for (std::size_t j = seenAt[path[i]]; j < i; ++j) {
+                    cycle.push_back(static_cast<int>(path[j]));
+                }
+                return makeCycle(out, std::move(cycle));
+            }
+            seenAt[path[i]] = i;
+        }
+        return std::nullopt; // Unreachable: n + 1 walk vertices must repeat
+    }
+
+    std::optional<MeanCycle> MinimumMeanCycle::howard(const SparseIndex& out, const SparseIndex& in) {
+        std::size_t n = out.vertices();
+
+        // Trim the vertices that cannot reach a cycle: repeatedly drop out-degree 0
+        std::vector<char> alive(n, 1);
+        std::vector<std::size_t> outDegree(n);
+        std::vector<std::size_t> dropped;
+        for (std::size_t v = 0; v < n; ++v) {
+            outDegree[v] = out.degree(v);
+            if (outDegree[v] == 0) {
+                dropped.push_back(v);
+            }
+        }
+        while (!dropped.empty()) {
+            std::size_t v = dropped.back();
+            dropped.pop_back();
+            alive[v] = 0;
+            for (std::size_t e = in.offsets[v]; e < in.offsets[v + 1]; ++e) {
+                std::size_t u = static_cast<std::size_t>(in.indices[e]);
+                if (alive[u] && --outDegree[u] == 0) {
+                    dropped.push_back(u);
+                }
+            }
+        }
+        if (std::find(alive.begin(), alive.end(), 1) == alive.end()) {
+            return std::nullopt;
+        }
+
+        // Start from the lightest live out-edge of every live vertex
+        std::vector<std::size_t> policy(n, NONE);
+        for (std::size_t u = 0; u < n; ++u) {
+            for (std::size_t e = out.offsets[u]; alive[u] && e < out.offsets[u + 1]; ++e) {
+                if (alive[static_cast<std::size_t>(out.indices[e])] &&
+                    (policy[u] == NONE || out.weights[e] < out.weights[policy[u]])) {
+                    policy[u] = e;
+                }
+            }
+        }
+        auto next = [&](std::size_t u) { return static_cast<std::size_t>(out.indices[policy[u]]); };
+
+        // Values: the mean of the policy cycle a vertex leads into (cycleNumerator /
+        // cycleDenominator of owner[v]), and value[v] = q * (weight to the cycle's anchor)
+        // - p * (edges to the anchor), the distance under weights w - p/q scaled by q
+        std::vector<std::size_t> owner(n);
+        std::vector<long long> value(n);
+        std::vector<long long> cycleNumerator, cycleDenominator;
+        std::vector<std::size_t> cycleAnchor;
+        std::vector<char> state(n);
+        std::vector<std::size_t> walk;
+        std::size_t iterationCap = std::max(HOWARD_MIN_ITERATIONS, n);
+        for (std::size_t iteration = 0; iteration < iterationCap; ++iteration) {
+            cycleNumerator.clear();
+            cycleDenominator.clear();
+            cycleAnchor.clear();
+            std::fill(state.begin(), state.end(), 0); // 0 new, 1 on the current walk, 2 valued
+            std::size_t best = NONE;
+            for (std::size_t s = 0; s < n; ++s) {
+                if (!alive[s] || state[s] != 0) {
+                    continue;
+                }
+                walk.clear();
+                std::size_t x = s;
+                while (state[x] == 0) {
+                    state[x] = 1;
+                    walk.push_back(x);
+                    x = next(x);
+                }
+                std::size_t anchor = NONE;
+                if (state[x] == 1) {
+                    // A new policy cycle through x; x anchors it at value 0
+                    long long weight = 0;
+                    long long length = 0;
+                    std::size_t u = x;
+                    do {
+                        weight += out.weights[policy[u]];
+                        ++length;
+                        u = next(u);
+                    } while (u != x);
+                    long long divisor = std::gcd(std::llabs(weight), length);
+                    std::size_t id = cycleAnchor.size();
+                    cycleNumerator.push_back(weight / divisor);
+                    cycleDenominator.push_back(length / divisor);
+                    cycleAnchor.push_back(x);
+                    owner[x] = id;
+                    value[x] = 0;
+                    anchor = x;
+                    if (best == NONE || lessRatio(cycleNumerator[id], cycleDenominator[id],
+                                                  cycleNumerator[best], cycleDenominator[best])) {
+                        best = id;
+                    }
+                }
+                // Value the walk back to front: each vertex's successor is valued first
+                for (std::size_t i = walk.size(); i-- > 0;) {
+                    std::size_t u = walk[i];
+                    state[u] = 2;
+                    if (u == anchor) {
+                        continue;
+                    }
+                    std::size_t v = next(u);
+                    std::size_t id = owner[v];
+                    owner[u] = id;
+                    value[u] = cycleDenominator[id] * out.weights[policy[u]] - cycleNumerator[id] + value[v];
+                }
+            }
+
+            // Improve: first towards smaller means, and only if none, towards smaller values
+            bool changed = false;
+            for (std::size_t u = 0; u < n; ++u) {
+                if (!alive[u]) {
+                    continue;
+                }
+                std::size_t choice = NONE;
+                std::size_t bestOwner = owner[u];
+                for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                    std::size_t v = static_cast<std::size_t>(out.indices[e]);
+                    if (alive[v] && lessRatio(cycleNumerator[owner[v]], cycleDenominator[owner[v]],
+                                              cycleNumerator[bestOwner], cycleDenominator[bestOwner])) {
+                        choice = e;
+                        bestOwner = owner[v];
+                    }
+                }
+                if (choice != NONE) {
+                    policy[u] = choice;
+                    changed = true;
+                }
+            }
+            bool meanImproved = changed;
+            for (std::size_t u = 0; u < n && !meanImproved; ++u) {
+                if (!alive[u]) {
+                    continue;
+                }
+                long long p = cycleNumerator[owner[u]];
+                long long q = cycleDenominator[owner[u]];
+                std::size_t choice = NONE;
+                long long bestValue = value[u];
+                for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                    std::size_t v = static_cast<std::size_t>(out.indices[e]);
+                    // Reduced fractions: equal means have equal numerators and denominators
+                    if (!alive[v] || cycleNumerator[owner[v]] != p || cycleDenominator[owner[v]] != q) {
+                        continue;
+                    }
+                    long long through = q * out.weights[e] - p + value[v];
+                    if (through < bestValue) {
+                        choice = e;
+                        bestValue = through;
+                    }
+                }
+                if (choice != NONE) {
+                    policy[u] = choice;
+                    changed = true;
+                }
+            }
+            if (!changed) {
+                std::vector<int> cycle;
+                std::size_t u = cycleAnchor[best];
+                do {
+                    cycle.push_back(static_cast<int>(u));
+                    u = next(u);
+                } while (u != cycleAnchor[best]);
+                return makeCycle(out, std::move(cycle));
+            }
+        }
+        return karp(out);
+    }
+} // namespace ariel
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Algorithms.hpp"
+#include "SparseIndex.hpp"
+#include <optional>
+
+#ifndef CPP_EX4_MEANCYCLE_HPP
+#define CPP_EX4_MEANCYCLE_HPP
+
+namespace ariel {
+    /**
+     * @brief Minimum mean-weight cycle by Karp's algorithm or Howard's policy iteration.
+     *
+     * Karp: D[k][v] is the lightest walk of exactly k edges ending at v (from anywhere). The
+     * minimum mean is min over v of max over k of (D[n][v] - D[k][v]) / (n - k), and the
+     * n-edge walk to a minimizing v repeats a vertex around a cycle of that mean.
+     *
+     * Howard: every vertex that can reach a cycle follows one chosen out-edge (its policy).
+     * Each cycle of the policy graph fixes the mean of the vertices that lead into it, and
+     * their values are the weights along the way relative to that mean. A vertex switches
+     * to an edge towards a smaller mean, or, when no mean improves, towards a smaller value.
+     * When nothing switches, the smallest policy cycle is optimal.
+     *
+     * Both work in integers: Howard scales the values of a vertex by the denominator of its
+     * mean, so no rounding can stall or mislead it. Products stay below 2^63 for every graph
+     * a dense adjacency matrix can hold in memory (V^2 * 2^32).
+     */
+    class MinimumMeanCycle {
+    public:
+        /**
+         * @brief Run Karp's algorithm.
+         *
+         * @param out The CSR index of the graph.
+         * @return The cycle, or std::nullopt if the graph is acyclic.
+         */
+        static std::optional<MeanCycle> karp(const SparseIndex& out);
+
+        /**
+         * @brief Run Howard's policy iteration.
+         *
+         * @param out The CSR index of the graph.
+         * @param in The CSC index of the same graph.
+         * @return The cycle, or std::nullopt if the graph is acyclic.
+         */
+        static std::optional<MeanCycle> howard(const SparseIndex& out, const SparseIndex& in);
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_MEANCYCLE_HPP
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "Parallel.hpp"
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#ifndef CPP_EX4_MULTISOURCEBFS_HPP
+#define CPP_EX4_MULTISOURCEBFS_HPP
+
+namespace ariel {
+    /**
+     * @brief Multi-source BFS (Then et al.): up to MAX_SOURCES traversals in one pass.
+     *
+     * Every vertex keeps one bit per source in seen, visit (current frontier) and visitNext
+     * words. Scanning a frontier vertex's edges once advances every traversal that has it
+     * in its frontier, so a batch shares the memory traffic that separate BFS runs would
+     * each repeat. Levels whose scan cost reaches PARALLEL_LEVEL_COST are split across
+     * workers, which merge bits into visitNext with atomic fetch_or.
+     */
+    class MultiSourceBFS {
+    public:
+        static constexpr std::size_t MAX_SOURCES = 512;
+        static constexpr std::size_t PARALLEL_LEVEL_COST = std::size_t{1} << 16;
+
+        // parent[slot * vertices + v]: the vertex before v on a BFS path from source slot,
+        // -1 if unreached; a source is its own parent. Only filled when tracking parents.
+        std::vector<int> parent;
+
+        /**
+         * @brief Traverse from every source at once.
+         *
+         * @param sources Distinct source vertices; source i uses slot i.
+         * @param goals (slot, vertex) pairs; the traversal stops once every goal is reached.
+         *              Empty means run to completion.
+         * @param trackParents Record the BFS trees in parent (sources * vertices entries).
+         */
+        template <typename Adjacency>
+        void run(const Adjacency& adjacency, const std::vector<std::size_t>& sources,
+                 const std::vector<std::pair<std::size_t, std::size_t>>& goals, bool trackParents) {
+            n = adjacency.vertices();
+            words = (sources.size() + 63) / 64;
+            seen.assign(n * words, 0);
+            visit.assign(n * words, 0);
+            visitNext.assign(n * words, 0);
+            queued.assign(n, 0);
+            parent.assign(trackParents ? sources.size() * n : 0, -1);
+            frontier.clear();
+            for (std::size_t slot = 0; slot < sources.size(); ++slot) {
+                std::size_t s = sources[slot];
+                std::uint64_t bit = std::uint64_t{1} << (slot % 64);
+                seen[s * words + slot / 64] |= bit;
+                visit[s * words + slot / 64] |= bit;
+                if (!queued[s]) {
+                    queued[s] = 1;
+                    frontier.push_back(s);
+                }
+                if (trackParents) {
+                    parent[slot * n + s] = static_cast<int>(s);
+                }
+            }
+            for (std::size_t s : frontier) {
+                queued[s] = 0;
+            }
+
+            pending = goals;
+            bool parallel = workerCount() > 1;
+            while (!frontier.empty() && !allGoalsReached()) {
+                std::size_t cost = 0;
+                for (std::size_t u : frontier) {
+                    cost += adjacency.scanCost(u);
+                }
+                std::size_t workers = parallel && cost >= PARALLEL_LEVEL_COST ? workerCount() : 1;
+                localQueues.resize(workers);
+                for (auto& local : localQueues) {
+                    local.clear();
+                }
+                if (workers == 1) {
+                    expand(adjacency, 0, frontier.size(), localQueues[0], trackParents);
+                } else {
+                    parallelForDynamic(frontier.size(), FRONTIER_CHUNK, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+                        expand(adjacency, begin, end, localQueues[worker], trackParents);
+                    });
+                }
+
+                // Settle the new bits; each vertex of next is owned by one iteration
+                for (std::size_t u : frontier) {
+                    for (std::size_t w = 0; w < words; ++w) {
+                        visit[u * words + w] = 0;
+                    }
+                }
+                next.clear();
+                for (const auto& local : localQueues) {
+                    next.insert(next.end(), local.begin(), local.end());
+                }
+                parallelFor(next.size(), SETTLE_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        std::size_t v = next[i];
+                        queued[v] = 0;
+                        for (std::size_t w = 0; w < words; ++w) {
+                            seen[v * words + w] |= visitNext[v * words + w];
+                        }
+                    }
+                });
+                visit.swap(visitNext);
+                frontier.swap(next);
+            }
+        }
+
+        /**
+         * @brief Check whether the last run reached a vertex from a source slot.
+         */
+        bool reached(std::size_t slot, std::size_t v) const {
+            return (seen[v * words + slot / 64] >> (slot % 64)) & 1U;
+        }
+
+    private:
+        // Frontier vertices claimed at a time by one worker
+        static constexpr std::size_t FRONTIER_CHUNK = 64;
+        // Newly reached vertices settled per worker chunk
+        static constexpr std::size_t SETTLE_GRAIN = 1 << 12;
+
+        std::size_t n = 0;
+        std::size_t words = 0;
+        std::vector<std::uint64_t> seen;
+        std::vector<std::uint64_t> visit;
+        std::vector<std::uint64_t> visitNext;
+        std::vector<char> queued;
+        std::vector<std::size_t> frontier;
+        std::vector<std::size_t> next;
+        std::vector<std::vector<std::size_t>> localQueues;
+        std::vector<std::pair<std::size_t, std::size_t>> pending;
+
+        bool allGoalsReached() {
+            if (pending.empty()) {
+                return false; // No goals: run until the frontier empties
+            }
+            std::erase_if(pending, [&](const auto& goal) { return reached(goal.first, goal.second); });
+            return pending.empty();
+        }
+
+        // Push the frontier bits of [begin, end) to their neighbors. seen is not written in
+        // this phase, so the bits that are new to a neighbor are stable; fetch_or tells which
+        // of them this edge delivered first, and that edge becomes the parent.
+        template <typename Adjacency>
+        void expand(const Adjacency& adjacency, std::size_t begin, std::size_t end,
+                    std::vector<std::size_t>& local, bool trackParents) {
+            for (std::size_t i = begin; i < end; ++i) {
+                std::size_t u = frontier[i];
+                adjacency.forEachOut(u, [&](std::size_t v, int) {
+                    bool delivered = false;
+                    for (std::size_t w = 0; w < words; ++w) {
+                        std::uint64_t bits = visit[u * words + w] & ~seen[v * words + w];
+                        if (bits == 0) {
+                            continue;
+                        }
+                        delivered = true;
+                        std::atomic_ref<std::uint64_t> slot(visitNext[v * words + w]);
+                        std::uint64_t fresh = bits & ~slot.fetch_or(bits, std::memory_order_relaxed);
+                        for (; trackParents && fresh != 0; fresh &= fresh - 1) {
+                            std::size_t source = w * 64 + static_cast<std::size_t>(std::countr_zero(fresh));
+                            parent[source * n + v] = static_cast<int>(u);
+                        }
+                    }
+                    if (delivered && std::atomic_ref<char>(queued[v]).exchange(1, std::memory_order_relaxed) == 0) {
+                        local.push_back(v);
+                    }
+                });
+            }
+        }
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_MULTISOURCEBFS_HPP
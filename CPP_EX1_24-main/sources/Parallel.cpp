@@ -0,0 +1,123 @@
+#include "Parallel.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ariel {
+
+    namespace {
+        std::atomic<std::size_t> configuredWorkers{0};
+
+        // Set on pool threads and on a caller while it runs worker 0, so nested loops run inline
+        thread_local bool insideTask = false;
+
+        // Threads that sleep between loops instead of being started and joined for each one.
+        // A loop bumps the generation; thread i wakes, runs worker i if the loop has that many
+        // workers, and the caller waits until every such worker has reported back.
+        class WorkerPool {
+        public:
+            WorkerPool() = default;
+            WorkerPool(const WorkerPool&) = delete;
+            WorkerPool& operator=(const WorkerPool&) = delete;
+
+            ~WorkerPool() {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    stopping = true;
+                }
+                wake.notify_all();
+                for (std::thread& thread : threads) {
+                    thread.join();
+                }
+            }
+
+            void run(std::size_t workers, detail::WorkerTask work, const void* argument) {
+                // One loop at a time; callers on other threads wait for the pool
+                std::lock_guard<std::mutex> submit(submitting);
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    while (threads.size() + 1 < workers) {
+                        threads.emplace_back(&WorkerPool::serve, this, threads.size() + 1, generation);
+                    }
+                    task = work;
+                    context = argument;
+                    active = workers;
+                    remaining = workers - 1;
+                    ++generation;
+                }
+                wake.notify_all();
+                insideTask = true;
+                work(argument, 0);
+                insideTask = false;
+                std::unique_lock<std::mutex> lock(mutex);
+                done.wait(lock, [this]() { return remaining == 0; });
+            }
+
+        private:
+            std::mutex submitting;
+            std::mutex mutex;
+            std::condition_variable wake;
+            std::condition_variable done;
+            std::vector<std::thread> threads;
+            std::uint64_t generation = 0;
+            detail::WorkerTask task = nullptr;
+            const void* context = nullptr;
+            std::size_t active = 0;
+            std::size_t remaining = 0;
+            bool stopping = false;
+
+            void serve(std::size_t index, std::uint64_t seen) {
+                insideTask = true;
+                std::unique_lock<std::mutex> lock(mutex);
+                for (;;) {
+                    wake.wait(lock, [&]() { return stopping || generation != seen; });
+                    if (stopping) {
+                        return;
+                    }
+                    seen = generation;
+                    if (index >= active) {
+                        continue;
+                    }
+                    detail::WorkerTask work = task;
+                    const void* argument = context;
+                    lock.unlock();
+                    work(argument, index);
+                    lock.lock();
+                    if (--remaining == 0) {
+                        done.notify_one();
+                    }
+                }
+            }
+        };
+    } // namespace
+
+    // hardware_concurrency() may report 0 when it cannot tell, so never go below one worker
+    std::size_t workerCount() {
+        std::size_t configured = configuredWorkers.load(std::memory_order_relaxed);
+        if (configured != 0) {
+            return configured;
+        }
+        return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    void setWorkerCount(std::size_t count) {
+        configuredWorkers.store(count, std::memory_order_relaxed);
+    }
+
+    namespace detail {
+        void runWorkers(std::size_t workers, WorkerTask task, const void* context) {
+            if (workers <= 1 || insideTask) {
+                for (std::size_t worker = 0; worker < workers; ++worker) {
+                    task(context, worker);
+                }
+                return;
+            }
+            static WorkerPool pool;
+            pool.run(workers, task, context);
+        }
+    } // namespace detail
+
+} // namespace ariel
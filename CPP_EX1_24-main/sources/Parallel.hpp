@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+#ifndef CPP_EX4_PARALLEL_HPP
+#define CPP_EX4_PARALLEL_HPP
+
+namespace ariel {
+    /**
+     * @brief Get the number of worker threads the parallel kernels may use.
+     *
+     * @return The configured count, or the hardware concurrency if none was set.
+     */
+    std::size_t workerCount();
+
+    /**
+     * @brief Override the number of worker threads (0 restores the hardware default).
+     *
+     * @param count The number of workers to use.
+     */
+    void setWorkerCount(std::size_t count);
+
+    namespace detail {
+        using WorkerTask = void (*)(const void* context, std::size_t worker);
+
+        /**
+         * @brief Call task(context, worker) once for every worker in [0, workers).
+         *
+         * Worker 0 runs on the calling thread and the others on a persistent pool, which
+         * grows to the largest count asked for and is reused by every later call. Calls made
+         * from inside a task (nested loops) run all their workers inline, one after another.
+         *
+         * @param workers The number of workers.
+         * @param task The function to call; it must not throw.
+         * @param context The argument passed through to task.
+         */
+        void runWorkers(std::size_t workers, WorkerTask task, const void* context);
+    } // namespace detail
+
+    /**
+     * @brief Run body(begin, end, worker) over [0, count) split into one contiguous chunk per worker.
+     *
+     * Runs inline on the calling thread when the range is smaller than two chunks of minChunk.
+     * Otherwise the calling thread takes the first chunk and pool threads take the rest, so
+     * no thread is started per call. The body must not throw.
+     *
+     * @param count The size of the index range.
+     * @param minChunk The smallest range worth handing to another thread.
+     * @param body The callable invoked once per chunk.
+     */
+    template <typename Body>
+    void parallelFor(std::size_t count, std::size_t minChunk, const Body& body) {
+        std::size_t chunks = minChunk == 0 ? count : (count + minChunk - 1) / minChunk;
+        std::size_t workers = std::min(workerCount(), chunks);
+        if (workers <= 1) {
+            if (count > 0) {
+                body(std::size_t{0}, count, std::size_t{0});
+            }
+            return;
+        }
+        std::size_t chunk = (count + workers - 1) / workers;
+        auto run = [&body, count, chunk](std::size_t worker) {
+            std::size_t begin = std::min(count, worker * chunk);
+            body(begin, std::min(count, begin + chunk), worker);
+        };
+        detail::runWorkers(workers, [](const void* context, std::size_t worker) {
+            (*static_cast<const decltype(run)*>(context))(worker);
+        }, &run);
+    }
+
+    /**
+     * @brief Run body(begin, end, worker) over [0, count) in chunks claimed dynamically.
+     *
+     * Workers repeatedly claim the next chunk from a shared cursor, so a worker that
+     * finishes early takes over work that a static split would have left to a slower one.
+     * The body must not throw.
+     *
+     * @param count The size of the index range.
+     * @param chunk The number of indices claimed at a time.
+     * @param body The callable invoked once per claimed chunk.
+     */
+    template <typename Body>
+    void parallelForDynamic(std::size_t count, std::size_t chunk, const Body& body) {
+        chunk = std::max<std::size_t>(1, chunk);
+        std::size_t chunks = (count + chunk - 1) / chunk;
+        std::atomic<std::size_t> cursor{0};
+        parallelFor(std::min(workerCount(), chunks), 1, [&](std::size_t, std::size_t, std::size_t worker) {
+            for (;;) {
+                std::size_t begin = cursor.fetch_add(chunk, std::memory_order_relaxed);
+                if (begin >= count) {
+                    return;
+                }
+                body(begin, std::min(count, begin + chunk), worker);
+            }
+        });
+    }
+} // namespace ariel
+
+#endif //CPP_EX4_PARALLEL_HPP
@@ -0,0 +1,203 @@
+#include "SpanningForest.hpp"
+#include "Dijkstra.hpp"
+#include "Parallel.hpp"
+#include "UnionFind.hpp"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+
+namespace ariel {
+
+    namespace {
+        using Edge = MinimumSpanningForest::Edge;
+
+        constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+        // Edges handled per worker chunk in a Boruvka pass
+        constexpr std::size_t BORUVKA_GRAIN = 1 << 12;
+
+        // Undirected weight of {u, v}: the lighter non-zero entry, 0 if neither is an edge
+        int pairWeight(const std::vector<std::vector<int>>& rows, bool symmetric, std::size_t u, std::size_t v) {
+            int forward = rows[u][v];
+            if (symmetric) {
+                return forward;
+            }
+            int backward = rows[v][u];
+            if (forward == 0 || backward == 0) {
+                return forward == 0 ? backward : forward;
+            }
+            return std::min(forward, backward);
+        }
+
+        SpanningForest finish(std::size_t vertices, std::vector<std::tuple<int, int, int>> edges) {
+            SpanningForest forest;
+            std::sort(edges.begin(), edges.end());
+            for (const auto& edge : edges) {
+                forest.weight += std::get<2>(edge);
+            }
+            forest.components = vertices - edges.size();
+            forest.edges = std::move(edges);
+            return forest;
+        }
+
+        std::tuple<int, int, int> asTuple(const Edge& edge) {
+            return {edge.u, edge.v, edge.weight};
+        }
+
+        void kruskal(Edge* first, Edge* last, UnionFind& sets, std::vector<std::tuple<int, int, int>>& out) {
+            std::sort(first, last, [](const Edge& a, const Edge& b) { return a.weight < b.weight; });
+            for (Edge* edge = first; edge != last; ++edge) {
+                if (sets.unite(edge->u, edge->v)) {
+                    out.push_back(asTuple(*edge));
+                }
+            }
+        }
+
+        void filterRange(Edge* first, Edge* last, UnionFind& sets, std::vector<std::tuple<int, int, int>>& out) {
+            std::size_t count = static_cast<std::size_t>(last - first);
+            if (count <= MinimumSpanningForest::KRUSKAL_SORT_EDGES) {
+                kruskal(first, last, sets, out);
+                return;
+            }
+            int a = first->weight;
+            int b = first[count / 2].weight;
+            int c = last[-1].weight;
+            int pivot = std::max(std::min(a, b), std::min(std::max(a, b), c)); // Median of three
+            Edge* split = std::partition(first, last, [&](const Edge& edge) { return edge.weight < pivot; });
+            if (split == first) {
+                split = std::partition(first, last, [&](const Edge& edge) { return edge.weight <= pivot; });
+            }
+            if (split == first || split == last) {
+                kruskal(first, last, sets, out); // Every weight equal: no split helps
+                return;
+            }
+            filterRange(first, split, sets, out);
+            Edge* kept = std::partition(split, last, [&](const Edge& edge) { return sets.find(edge.u) != sets.find(edge.v); });
+            filterRange(split, kept, sets, out);
+        }
+    } // namespace
+
+    std::vector<Edge> MinimumSpanningForest::undirectedEdges(const std::vector<std::vector<int>>& rows, bool symmetric) {
+        std::vector<Edge> edges;
+        for (std::size_t u = 0; u < rows.size(); ++u) {
+            for (std::size_t v = u + 1; v < rows.size(); ++v) {
+                int weight = pairWeight(rows, symmetric, u, v);
+                if (weight != 0) {
+                    edges.push_back(Edge{static_cast<int>(u), static_cast<int>(v), weight});
+                }
+            }
+        }
+        return edges;
+    }
+
+    SpanningForest MinimumSpanningForest::prim(const std::vector<std::vector<int>>& rows, bool symmetric) {
+        std::size_t n = rows.size();
+        std::vector<long long> key(n, LLONG_MAX); // Lightest known edge into the tree
+        std::vector<int> link(n, -1);             // Tree vertex at the other end of that edge
+        std::vector<char> inTree(n, 0);
+        std::vector<std::tuple<int, int, int>> edges;
+        DAryHeap heap;
+        heap.reset(n);
+        for (std::size_t root = 0; root < n; ++root) {
+            if (inTree[root]) {
+                continue;
+            }
+            key[root] = LLONG_MIN;
+            heap.pushOrDecrease(root, key);
+            while (!heap.empty()) {
+                std::size_t u = heap.pop(key);
+                inTree[u] = 1;
+                if (link[u] >= 0) {
+                    int from = std::min(link[u], static_cast<int>(u));
+                    int to = std::max(link[u], static_cast<int>(u));
+                    edges.emplace_back(from, to, static_cast<int>(key[u]));
+                }
+                for (std::size_t v = 0; v < n; ++v) {
+                    if (inTree[v]) {
+                        continue;
+                    }
+                    int weight = pairWeight(rows, symmetric, u, v);
+                    if (weight != 0 && weight < key[v]) {
+                        key[v] = weight;
+                        link[v] = static_cast<int>(u);
+                        heap.pushOrDecrease(v, key);
+                    }
+                }
+            }
+        }
+        return finish(n, std::move(edges));
+    }
+
+    SpanningForest MinimumSpanningForest::filterKruskal(std::size_t vertices, std::vector<Edge> edges) {
+        UnionFind sets(vertices);
+        std::vector<std::tuple<int, int, int>> chosen;
+        filterRange(edges.data(), edges.data() + edges.size(), sets, chosen);
+        return finish(vertices, std::move(chosen));
+    }
+
+    SpanningForest MinimumSpanningForest::boruvka(std::size_t vertices, std::vector<Edge> edges) {
+        UnionFind sets(vertices);
+        // Strict total order on edges, so every component's pick is unique and the picks
+        // of one round form a forest
+        auto lighter = [&](std::size_t a, std::size_t b) {
+            return edges[a].weight < edges[b].weight || (edges[a].weight == edges[b].weight && a < b);
+        };
+        std::vector<std::size_t> live(edges.size());
+        for (std::size_t e = 0; e < edges.size(); ++e) {
+            live[e] = e;
+        }
+        std::vector<std::size_t> best(vertices, NONE); // Lightest edge leaving each root
+        std::vector<char> internal(edges.size(), 0);
+        std::vector<std::vector<std::tuple<int, int, int>>> chosen(workerCount());
+
+        while (!live.empty()) {
+            std::atomic<bool> picked{false};
+            parallelFor(live.size(), BORUVKA_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+                bool local = false;
+                for (std::size_t i = begin; i < end; ++i) {
+                    std::size_t e = live[i];
+                    int ru = sets.find(edges[e].u);
+                    int rv = sets.find(edges[e].v);
+                    if (ru == rv) {
+                        internal[e] = 1;
+                        continue;
+                    }
+                    local = true;
+                    for (int root : {ru, rv}) {
+                        std::atomic_ref<std::size_t> slot(best[static_cast<std::size_t>(root)]);
+                        std::size_t current = slot.load(std::memory_order_relaxed);
+                        while ((current == NONE || lighter(e, current)) &&
+                               !slot.compare_exchange_weak(current, e, std::memory_order_relaxed)) {
+                        }
+                    }
+                }
+                if (local) {
+                    picked.store(true, std::memory_order_relaxed);
+                }
+            });
+            if (!picked.load()) {
+                break;
+            }
+
+            // Unite along every pick; an edge picked from both sides only unites once
+            parallelFor(vertices, BORUVKA_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+                for (std::size_t c = begin; c < end; ++c) {
+                    std::size_t e = best[c];
+                    if (e == NONE) {
+                        continue;
+                    }
+                    best[c] = NONE;
+                    if (sets.unite(edges[e].u, edges[e].v)) {
+                        chosen[worker].push_back(asTuple(edges[e]));
+                    }
+                }
+            });
+            std::erase_if(live, [&](std::size_t e) { return internal[e] != 0; });
+        }
+
+        std::vector<std::tuple<int, int, int>> forest;
+        for (const auto& local : chosen) {
+            forest.insert(forest.end(), local.begin(), local.end());
+        }
+        return finish(vertices, std::move(forest));
+    }
+} // namespace ariel
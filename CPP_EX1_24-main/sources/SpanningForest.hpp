@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Algorithms.hpp"
+#include <cstddef>
+#include <vector>
+
+#ifndef CPP_EX4_SPANNINGFOREST_HPP
+#define CPP_EX4_SPANNINGFOREST_HPP
+
+namespace ariel {
+    /**
+     * @brief Minimum spanning forest engines.
+     *
+     * Prim grows one tree at a time from a 4-ary indexed heap and reads the adjacency
+     * matrix directly, so dense graphs pay no edge-list construction.
+     *
+     * Filter-Kruskal partitions the edges around a pivot weight, solves the light half
+     * first, then drops every heavy edge whose endpoints that already joined before
+     * recursing on the rest. Only the edges that survive the filters are ever sorted.
+     *
+     * Boruvka lets every component pick its lightest outgoing edge in parallel (CAS on a
+     * per-component slot) and unites along all of them at once, at least halving the number
+     * of components per round. Edges are ordered by (weight, index), so the picks never
+     * close a cycle even with equal weights.
+     */
+    class MinimumSpanningForest {
+    public:
+        struct Edge {
+            int u;
+            int v;
+            int weight;
+        };
+
+        // Edges from which Boruvka's parallel rounds pay for their passes over the edge list
+        static constexpr std::size_t PARALLEL_MIN_EDGES = std::size_t{1} << 16;
+        // Edge counts at or below which filter-Kruskal just sorts
+        static constexpr std::size_t KRUSKAL_SORT_EDGES = 1024;
+
+        /**
+         * @brief List every undirected edge once, with u < v and the lighter matrix entry.
+         *
+         * @param rows The adjacency matrix.
+         * @param symmetric Whether the matrix is symmetric (then only the upper triangle is read).
+         * @return The edges.
+         */
+        static std::vector<Edge> undirectedEdges(const std::vector<std::vector<int>>& rows, bool symmetric);
+
+        /**
+         * @brief Run Prim's algorithm from every vertex not yet in a tree.
+         *
+         * @param rows The adjacency matrix.
+         * @param symmetric Whether the matrix is symmetric.
+         * @return The forest.
+         */
+        static SpanningForest prim(const std::vector<std::vector<int>>& rows, bool symmetric);
+
+        /**
+         * @brief Run filter-Kruskal.
+         *
+         * @param vertices The number of vertices.
+         * @param edges The undirected edges.
+         * @return The forest.
+         */
+        static SpanningForest filterKruskal(std::size_t vertices, std::vector<Edge> edges);
+
+        /**
+         * @brief Run parallel Boruvka.
+         *
+         * @param vertices The number of vertices.
+         * @param edges The undirected edges.
+         * @return The forest.
+         */
+        static SpanningForest boruvka(std::size_t vertices, std::vector<Edge> edges);
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_SPANNINGFOREST_HPP
@@ -0,0 +1,84 @@
+#include "SparseIndex.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace ariel {
+
+    namespace {
+        // Below this many rows plus entries a single thread finishes before others would start
+        constexpr std::size_t SPMV_PARALLEL_WORK = 1 << 15;
+
+        // Merge-path search: find how many rows are completed at the given diagonal of the
+        // (row ends) x (entry indices) merge grid. Returns (row, entry) with row + entry == diagonal.
+        std::pair<std::size_t, std::size_t> mergePathSearch(std::size_t diagonal, const std::vector<std::size_t>& offsets,
+                                                            std::size_t rows, std::size_t entries) {
+            std::size_t low = diagonal > entries ? diagonal - entries : 0;
+            std::size_t high = std::min(diagonal, rows);
+            while (low < high) {
+                std::size_t pivot = low + (high - low) / 2;
+                if (offsets[pivot + 1] + pivot + 1 <= diagonal) {
+                    low = pivot + 1;
+                } else {
+                    high = pivot;
+                }
+            }
+            return {low, diagonal - low};
+        }
+    } // namespace
+
+    // An empty index has no offsets at all, so guard the "size - 1".
+    std::size_t SparseIndex::vertices() const {
+        return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    std::size_t SparseIndex::nonZeros() const {
+        return indices.size();
+    }
+
+    std::size_t SparseIndex::degree(std::size_t vertex) const {
+        return offsets[vertex + 1] - offsets[vertex];
+    }
+
+    // Merge-path SpMV: every partition consumes the same number of (row end + entry) steps.
+    // A row split between partitions leaves a partial sum that is added back afterwards.
+    std::vector<double> SparseIndex::mxv(const std::vector<double>& x) const {
+        std::size_t rows = vertices();
+        if (x.size() != rows) {
+            throw std::invalid_argument("Vector size must match the number of vertices");
+        }
+        std::vector<double> y(rows, 0.0);
+        std::size_t entries = nonZeros();
+        std::size_t work = rows + entries;
+        std::size_t partitions = work < SPMV_PARALLEL_WORK ? 1 : workerCount();
+        std::vector<std::pair<std::size_t, double>> carry(partitions, {rows, 0.0});
+
+        parallelFor(partitions, 1, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t part = begin; part < end; ++part) {
+                auto [row, entry] = mergePathSearch(part * work / partitions, offsets, rows, entries);
+                auto [rowEnd, entryEnd] = mergePathSearch((part + 1) * work / partitions, offsets, rows, entries);
+                for (; row < rowEnd; ++row) {
+                    double sum = 0.0;
+                    for (; entry < offsets[row + 1]; ++entry) {
+                        sum += weights[entry] * x[static_cast<std::size_t>(indices[entry])];
+                    }
+                    y[row] = sum;
+                }
+                double partial = 0.0;
+                for (; entry < entryEnd; ++entry) {
+                    partial += weights[entry] * x[static_cast<std::size_t>(indices[entry])];
+                }
+                carry[part] = {rowEnd, partial};
+            }
+        });
+
+        for (const auto& [row, partial] : carry) {
+            if (row < rows) {
+                y[row] += partial;
+            }
+        }
+        return y;
+    }
+
+} // namespace ariel
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#ifndef CPP_EX4_SPARSEINDEX_HPP
+#define CPP_EX4_SPARSEINDEX_HPP
+
+namespace ariel {
+    /**
+     * @brief Sparse vector given as parallel arrays of positions and values.
+     */
+    struct SparseVector {
+        std::vector<int> indices;
+        std::vector<double> values;
+    };
+
+    /**
+     * @brief Compressed index over the non-zero entries of an adjacency matrix.
+     *
+     * Used both as CSR (one range per row, indices are target vertices) and as
+     * CSC (one range per column, indices are source vertices). Vertex v owns the
+     * entries [offsets[v], offsets[v + 1]) of indices and weights, sorted by index.
+     */
+    struct SparseIndex {
+        std::vector<std::size_t> offsets; // vertices() + 1 entries
+        std::vector<int> indices;         // Neighbor of each stored entry
+        std::vector<int> weights;         // Weight of each stored entry
+
+        /**
+         * @brief Get the number of vertices covered by the index.
+         *
+         * @return The number of vertices.
+         */
+        std::size_t vertices() const;
+
+        /**
+         * @brief Get the number of stored (non-zero) entries.
+         *
+         * @return The number of entries.
+         */
+        std::size_t nonZeros() const;
+
+        /**
+         * @brief Get the number of entries stored for a vertex.
+         *
+         * @param vertex The index of the vertex.
+         * @return The degree of the vertex in this index.
+         */
+        std::size_t degree(std::size_t vertex) const;
+
+        /**
+         * @brief Sparse matrix-vector product y[v] = sum of weight * x[index] over the entries of v.
+         *
+         * On a CSR index this is A * x; on a CSC index it is x * A. Work is split across
+         * workers with merge-path partitioning, so skewed degree distributions stay balanced.
+         *
+         * @param x The dense input vector, one value per vertex.
+         * @return The dense result vector.
+         * @throw std::invalid_argument If x does not have one entry per vertex.
+         */
+        std::vector<double> mxv(const std::vector<double>& x) const;
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_SPARSEINDEX_HPP
@@ -0,0 +1,310 @@
+#include "StronglyConnected.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+namespace ariel {
+
+    namespace {
+        constexpr int NONE = -1;
+        // Vertices per worker chunk in the whole-graph passes
+        constexpr std::size_t VERTEX_GRAIN = 1 << 12;
+        // Frontier vertices claimed at a time by a reach worker
+        constexpr std::size_t FRONTIER_CHUNK = 256;
+        // Trimming stops once a pass peels fewer than 1 / TRIM_STOP of the live vertices
+        constexpr std::size_t TRIM_STOP = 64;
+
+        // Tarjan over the live vertices; rep[v] becomes the root of v's component
+        void tarjanLive(const SparseIndex& out, const std::vector<char>& live, std::vector<int>& rep) {
+            std::size_t n = out.vertices();
+            std::vector<int> order(n, NONE); // Discovery index
+            std::vector<int> low(n, 0);
+            std::vector<char> onStack(n, 0);
+            std::vector<std::size_t> stack;
+            std::vector<std::pair<std::size_t, std::size_t>> calls; // (vertex, next edge to scan)
+            int counter = 0;
+            auto open = [&](std::size_t v) {
+                order[v] = low[v] = counter++;
+                stack.push_back(v);
+                onStack[v] = 1;
+                calls.emplace_back(v, out.offsets[v]);
+            };
+            for (std::size_t root = 0; root < n; ++root) {
+                if (!live[root] || order[root] != NONE) {
+                    continue;
+                }
+                open(root);
+                while (!calls.empty()) {
+                    auto& [u, e] = calls.back();
+                    if (e < out.offsets[u + 1]) {
+                        std::size_t v = static_cast<std::size_t>(out.indices[e++]);
+                        if (!live[v]) {
+                            continue;
+                        }
+                        if (order[v] == NONE) {
+                            open(v); // Invalidates u and e
+                        } else if (onStack[v]) {
+                            low[u] = std::min(low[u], order[v]);
+                        }
+                        continue;
+                    }
+                    std::size_t done = u;
+                    calls.pop_back();
+                    if (low[done] == order[done]) {
+                        std::size_t w;
+                        do {
+                            w = stack.back();
+                            stack.pop_back();
+                            onStack[w] = 0;
+                            rep[w] = static_cast<int>(done);
+                        } while (w != done);
+                    }
+                    if (!calls.empty()) {
+                        std::size_t caller = calls.back().first;
+                        low[caller] = std::min(low[caller], low[done]);
+                    }
+                }
+            }
+        }
+
+        // Number components by their smallest member; rep[v] is any member of v's component
+        std::vector<int> canonical(std::vector<int> rep) {
+            std::vector<int> id(rep.size(), NONE);
+            int next = 0;
+            for (std::size_t v = 0; v < rep.size(); ++v) {
+                std::size_t root = static_cast<std::size_t>(rep[v]);
+                if (id[root] == NONE) {
+                    id[root] = next++;
+                }
+                rep[v] = id[root];
+            }
+            return rep;
+        }
+
+        bool hasLiveNeighbour(const SparseIndex& index, std::size_t v, std::vector<char>& live) {
+            for (std::size_t e = index.offsets[v]; e < index.offsets[v + 1]; ++e) {
+                std::size_t w = static_cast<std::size_t>(index.indices[e]);
+                if (w != v && std::atomic_ref<char>(live[w]).load(std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Peel vertices without a live in- or out-neighbour until a pass stops paying off.
+        // Peeling in place is safe: a dead neighbour's component is already complete, so it
+        // cannot contain a live vertex.
+        void trim(const SparseIndex& out, const SparseIndex& in, std::vector<char>& live, std::vector<int>& rep,
+                  std::size_t& remaining, std::size_t sequentialVertices) {
+            std::size_t n = out.vertices();
+            while (remaining > sequentialVertices) {
+                std::atomic<std::size_t> peeled{0};
+                parallelFor(n, VERTEX_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    std::size_t local = 0;
+                    for (std::size_t v = begin; v < end; ++v) {
+                        std::atomic_ref<char> alive(live[v]);
+                        if (alive.load(std::memory_order_relaxed) &&
+                            (!hasLiveNeighbour(in, v, live) || !hasLiveNeighbour(out, v, live))) {
+                            rep[v] = static_cast<int>(v);
+                            alive.store(0, std::memory_order_relaxed);
+                            ++local;
+                        }
+                    }
+                    peeled.fetch_add(local, std::memory_order_relaxed);
+                });
+                std::size_t count = peeled.load();
+                std::size_t before = remaining;
+                remaining -= count;
+                if (count * TRIM_STOP < before) {
+                    break;
+                }
+            }
+        }
+
+        // Level-synchronous BFS from source over the vertices marked from, re-marking them to
+        void reach(const SparseIndex& index, std::size_t source, std::vector<int>& mark, int from, int to) {
+            std::vector<std::size_t> frontier{source};
+            std::vector<std::vector<std::size_t>> next(workerCount());
+            mark[source] = to;
+            while (!frontier.empty()) {
+                parallelForDynamic(frontier.size(), FRONTIER_CHUNK, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+                    for (std::size_t i = begin; i < end; ++i) {
+                        std::size_t u = frontier[i];
+                        for (std::size_t e = index.offsets[u]; e < index.offsets[u + 1]; ++e) {
+                            std::size_t v = static_cast<std::size_t>(index.indices[e]);
+                            std::atomic_ref<int> slot(mark[v]);
+                            int expected = from;
+                            if (slot.load(std::memory_order_relaxed) == from &&
+                                slot.compare_exchange_strong(expected, to, std::memory_order_relaxed)) {
+                                next[worker].push_back(v);
+                            }
+                        }
+                    }
+                });
+                frontier.clear();
+                for (auto& local : next) {
+                    frontier.insert(frontier.end(), local.begin(), local.end());
+                    local.clear();
+                }
+            }
+        }
+
+        // Drop the vertices given a component since the last call; returns how many remain
+        std::size_t retire(std::vector<char>& live, const std::vector<int>& rep) {
+            std::atomic<std::size_t> remaining{0};
+            parallelFor(live.size(), VERTEX_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+                std::size_t local = 0;
+                for (std::size_t v = begin; v < end; ++v) {
+                    live[v] = live[v] && rep[v] == NONE;
+                    local += live[v] ? std::size_t{1} : std::size_t{0};
+                }
+                remaining.fetch_add(local, std::memory_order_relaxed);
+            });
+            return remaining.load();
+        }
+    } // namespace
+
+    std::vector<int> StronglyConnectedComponents::tarjan(const SparseIndex& out) {
+        std::vector<int> rep(out.vertices(), NONE);
+        tarjanLive(out, std::vector<char>(out.vertices(), 1), rep);
+        return canonical(std::move(rep));
+    }
+
+    std::vector<int> StronglyConnectedComponents::forwardBackward(const SparseIndex& out, const SparseIndex& in,
+                                                                  std::size_t sequentialVertices) {
+        std::size_t n = out.vertices();
+        std::vector<int> rep(n, NONE);
+        std::vector<char> live(n, 1);
+        std::size_t remaining = n;
+        trim(out, in, live, rep, remaining, sequentialVertices);
+
+        // Forward-backward from the live vertex with the most in-out pairs, which is likely
+        // to sit in the largest component
+        if (remaining > sequentialVertices) {
+            std::size_t pivot = 0;
+            std::size_t bestScore = 0;
+            for (std::size_t v = 0; v < n; ++v) {
+                std::size_t score = (in.degree(v) + 1) * (out.degree(v) + 1);
+                if (live[v] && score > bestScore) {
+                    pivot = v;
+                    bestScore = score;
+                }
+            }
+            std::vector<int> mark(n);
+            for (std::size_t v = 0; v < n; ++v) {
+                mark[v] = live[v] ? 0 : NONE;
+            }
+            reach(out, pivot, mark, 0, 1);
+            reach(in, pivot, mark, 1, 2);
+            for (std::size_t v = 0; v < n; ++v) {
+                if (mark[v] == 2) {
+                    rep[v] = static_cast<int>(pivot);
+                }
+            }
+            remaining = retire(live, rep);
+            trim(out, in, live, rep, remaining, sequentialVertices);
+        }
+
+        std::vector<int> color(n);
+        std::vector<std::size_t> roots;
+        std::vector<std::vector<std::size_t>> stacks(workerCount());
+        while (remaining > sequentialVertices) {
+            // Propagate the largest vertex id forward; every vertex ends with the largest id
+            // that reaches it, and the owner of that id is in its own color
+            parallelFor(n, VERTEX_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t v = begin; v < end; ++v) {
+                    color[v] = live[v] ? static_cast<int>(v) : NONE;
+                }
+            });
+            std::atomic<bool> moved{true};
+            while (moved.exchange(false)) {
+                parallelFor(n, VERTEX_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+                    bool local = false;
+                    for (std::size_t u = begin; u < end; ++u) {
+                        if (!live[u]) {
+                            continue;
+                        }
+                        int c = std::atomic_ref<int>(color[u]).load(std::memory_order_relaxed);
+                        for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                            std::size_t v = static_cast<std::size_t>(out.indices[e]);
+                            if (!live[v]) {
+                                continue;
+                            }
+                            std::atomic_ref<int> slot(color[v]);
+                            int current = slot.load(std::memory_order_relaxed);
+                            while (current < c && !slot.compare_exchange_weak(current, c, std::memory_order_relaxed)) {
+                            }
+                            local = local || current < c;
+                        }
+                    }
+                    if (local) {
+                        moved.store(true, std::memory_order_relaxed);
+                    }
+                });
+            }
+
+            // A root's component is what reaches it backwards inside its color. Colors are
+            // disjoint, so each root's search runs alone
+            roots.clear();
+            for (std::size_t v = 0; v < n; ++v) {
+                if (live[v] && color[v] == static_cast<int>(v)) {
+                    roots.push_back(v);
+                }
+            }
+            parallelForDynamic(roots.size(), 1, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+                std::vector<std::size_t>& stack = stacks[worker];
+                for (std::size_t i = begin; i < end; ++i) {
+                    int root = static_cast<int>(roots[i]);
+                    rep[roots[i]] = root;
+                    stack.push_back(roots[i]);
+                    while (!stack.empty()) {
+                        std::size_t u = stack.back();
+                        stack.pop_back();
+                        for (std::size_t e = in.offsets[u]; e < in.offsets[u + 1]; ++e) {
+                            std::size_t w = static_cast<std::size_t>(in.indices[e]);
+                            if (color[w] == root && rep[w] == NONE) {
+                                rep[w] = root;
+                                stack.push_back(w);
+                            }
+                        }
+                    }
+                }
+            });
+            remaining = retire(live, rep);
+            trim(out, in, live, rep, remaining, sequentialVertices);
+        }
+
+        tarjanLive(out, live, rep);
+        return canonical(std::move(rep));
+    }
+
+    SparseIndex StronglyConnectedComponents::condense(const SparseIndex& out, const std::vector<int>& label,
+                                                      std::size_t components) {
+        // (target, weight) per component; sorting puts the lightest of each target first
+        std::vector<std::vector<std::pair<int, int>>> rows(components);
+        for (std::size_t u = 0; u < out.vertices(); ++u) {
+            for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                int from = label[u];
+                int to = label[static_cast<std::size_t>(out.indices[e])];
+                if (from != to) {
+                    rows[static_cast<std::size_t>(from)].emplace_back(to, out.weights[e]);
+                }
+            }
+        }
+        SparseIndex dag;
+        dag.offsets.assign(components + 1, 0);
+        for (std::size_t c = 0; c < components; ++c) {
+            std::vector<std::pair<int, int>>& row = rows[c];
+            std::sort(row.begin(), row.end());
+            for (std::size_t i = 0; i < row.size(); ++i) {
+                if (i == 0 || row[i].first != row[i - 1].first) {
+                    dag.indices.push_back(row[i].first);
+                    dag.weights.push_back(row[i].second);
+                }
+            }
+            dag.offsets[c + 1] = dag.indices.size();
+        }
+        return dag;
+    }
+} // namespace ariel
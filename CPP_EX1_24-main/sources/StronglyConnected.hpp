@@ -0,0 +1,69 @@
+#pragma once
+
+#include "SparseIndex.hpp"
+#include <cstddef>
+#include <vector>
+
+#ifndef CPP_EX4_STRONGLYCONNECTED_HPP
+#define CPP_EX4_STRONGLYCONNECTED_HPP
+
+namespace ariel {
+    /**
+     * @brief Strongly connected component engines.
+     *
+     * Tarjan runs on an explicit call stack, so deep graphs cannot overflow the native one.
+     *
+     * Forward-backward takes the steps that suit parallel hardware:
+     * - Trimming peels every vertex that has no live in-neighbour or no live
+     *   out-neighbour; such a vertex is a component of its own.
+     * - One forward-backward split cuts out the component of a high-degree pivot (the
+     *   giant component, if there is one) as the intersection of its forward and backward
+     *   reach.
+     * - Coloring handles the rest. Vertex ids propagate forward as maxima until stable;
+     *   each vertex that keeps its own id is a root, and its component is what reaches it
+     *   backwards within its color.
+     * Once few vertices are left, Tarjan finishes them sequentially.
+     *
+     * Both engines label components by their smallest vertex, so their results match exactly.
+     */
+    class StronglyConnectedComponents {
+    public:
+        // Live vertices below which forward-backward hands over to Tarjan
+        static constexpr std::size_t SEQUENTIAL_VERTICES = std::size_t{1} << 12;
+        // Edges from which the parallel engine pays for its extra passes
+        static constexpr std::size_t PARALLEL_MIN_EDGES = std::size_t{1} << 16;
+
+        /**
+         * @brief Label the components with iterative Tarjan.
+         *
+         * @param out The out-edges.
+         * @return The component of each vertex, numbered by smallest member.
+         */
+        static std::vector<int> tarjan(const SparseIndex& out);
+
+        /**
+         * @brief Label the components with parallel trimming, forward-backward and coloring.
+         *
+         * @param out The out-edges.
+         * @param in The in-edges.
+         * @param sequentialVertices Live vertices at or below which Tarjan takes over.
+         * @return The component of each vertex, numbered by smallest member.
+         */
+        static std::vector<int> forwardBackward(const SparseIndex& out, const SparseIndex& in,
+                                                std::size_t sequentialVertices = SEQUENTIAL_VERTICES);
+
+        /**
+         * @brief Build the condensation: one vertex per component and an edge between two
+         * components whenever some edge joins them.
+         *
+         * @param out The out-edges.
+         * @param label The component of each vertex.
+         * @param components The number of components.
+         * @return The component graph. It is acyclic, and each edge has the lightest weight
+         *         among the edges it stands for.
+         */
+        static SparseIndex condense(const SparseIndex& out, const std::vector<int>& label, std::size_t components);
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_STRONGLYCONNECTED_HPP
@@ -0,0 +1,154 @@
+#include "Topological.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <atomic>
+
+namespace ariel {
+
+    namespace {
+        // Vertices per worker chunk in the whole-graph passes
+        constexpr std::size_t VERTEX_GRAIN = 1 << 12;
+        // Level vertices claimed at a time by a worker
+        constexpr std::size_t LEVEL_CHUNK = 256;
+
+        // Kahn stopped early: every vertex it left has a predecessor that it also left, so
+        // walking predecessors backwards inside that set must repeat. The cycle is rotated
+        // to start at its smallest vertex
+        std::vector<int> leftoverCycle(const SparseIndex& out, const std::vector<int>& pending) {
+            std::size_t n = out.vertices();
+            std::vector<int> predecessor(n, -1);
+            std::size_t start = n;
+            for (std::size_t u = 0; u < n; ++u) {
+                if (pending[u] == 0) {
+                    continue;
+                }
+                start = std::min(start, u);
+                for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                    std::size_t v = static_cast<std::size_t>(out.indices[e]);
+                    if (pending[v] > 0) {
+                        predecessor[v] = static_cast<int>(u);
+                    }
+                }
+            }
+            std::vector<int> seenAt(n, -1);
+            std::vector<int> walk;
+            std::size_t x = start;
+            while (seenAt[x] < 0) {
+                seenAt[x] = static_cast<int>(walk.size());
+                walk.push_back(static_cast<int>(x));
+                x = static_cast<std::size_t>(predecessor[x]);
+            }
+            // walk[seenAt[x]], ... is the cycle backwards
+            std::vector<int> cycle(walk.begin() + seenAt[x], walk.end());
+            std::reverse(cycle.begin(), cycle.end());
+            std::rotate(cycle.begin(), std::min_element(cycle.begin(), cycle.end()), cycle.end());
+            return cycle;
+        }
+    } // namespace
+
+    TopologicalOrder TopologicalSort::run(const SparseIndex& out) {
+        std::size_t n = out.vertices();
+        std::vector<int> pending(n, 0); // Predecessors not yet ordered
+        parallelFor(n, VERTEX_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t u = begin; u < end; ++u) {
+                for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                    std::atomic_ref<int>(pending[static_cast<std::size_t>(out.indices[e])]).fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+
+        TopologicalOrder result;
+        result.order.reserve(n);
+        result.level.assign(n, -1);
+        std::vector<int> frontier;
+        for (std::size_t v = 0; v < n; ++v) {
+            if (pending[v] == 0) {
+                frontier.push_back(static_cast<int>(v));
+            }
+        }
+        std::vector<std::vector<int>> next(workerCount());
+        for (int level = 0; !frontier.empty(); ++level) {
+            for (int v : frontier) {
+                result.level[static_cast<std::size_t>(v)] = level;
+            }
+            result.order.insert(result.order.end(), frontier.begin(), frontier.end());
+            parallelForDynamic(frontier.size(), LEVEL_CHUNK, [&](std::size_t begin, std::size_t end, std::size_t worker) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    std::size_t u = static_cast<std::size_t>(frontier[i]);
+                    for (std::size_t e = out.offsets[u]; e < out.offsets[u + 1]; ++e) {
+                        int v = out.indices[e];
+                        std::atomic_ref<int> count(pending[static_cast<std::size_t>(v)]);
+                        if (count.fetch_sub(1, std::memory_order_relaxed) == 1) {
+                            next[worker].push_back(v);
+                        }
+                    }
+                }
+            });
+            frontier.clear();
+            for (auto& local : next) {
+                frontier.insert(frontier.end(), local.begin(), local.end());
+                local.clear();
+            }
+            std::sort(frontier.begin(), frontier.end());
+        }
+
+        if (result.order.size() < n) {
+            result.order.clear();
+            result.level.clear();
+            result.cycle = leftoverCycle(out, pending);
+        }
+        return result;
+    }
+
+    void TopologicalSort::paths(const SparseIndex& in, const TopologicalOrder& order, std::size_t source, bool longest,
+                                std::vector<long long>& distance, std::vector<int>& parent) {
+        const long long unreached = ShortestPathTree::UNREACHABLE;
+        std::size_t n = in.vertices();
+        if (source == ALL_SOURCES) {
+            distance.assign(n, 0);
+            parent.resize(n);
+            for (std::size_t v = 0; v < n; ++v) {
+                parent[v] = static_cast<int>(v);
+            }
+        } else {
+            distance.assign(n, unreached);
+            parent.assign(n, -1);
+            distance[source] = 0;
+            parent[source] = static_cast<int>(source);
+        }
+
+        // Level 0 has no in-edges; every later level only reads the ones before it
+        std::size_t begin = 0;
+        while (begin < n && order.level[static_cast<std::size_t>(order.order[begin])] == 0) {
+            ++begin;
+        }
+        while (begin < n) {
+            int level = order.level[static_cast<std::size_t>(order.order[begin])];
+            std::size_t end = begin;
+            while (end < n && order.level[static_cast<std::size_t>(order.order[end])] == level) {
+                ++end;
+            }
+            parallelForDynamic(end - begin, LEVEL_CHUNK, [&](std::size_t first, std::size_t last, std::size_t) {
+                for (std::size_t i = begin + first; i < begin + last; ++i) {
+                    std::size_t v = static_cast<std::size_t>(order.order[i]);
+                    long long best = distance[v];
+                    int from = parent[v];
+                    for (std::size_t e = in.offsets[v]; e < in.offsets[v + 1]; ++e) {
+                        std::size_t u = static_cast<std::size_t>(in.indices[e]);
+                        if (distance[u] == unreached) {
+                            continue;
+                        }
+                        long long through = distance[u] + in.weights[e];
+                        if (best == unreached || (longest ? through > best : through < best)) {
+                            best = through;
+                            from = static_cast<int>(u);
+                        }
+                    }
+                    distance[v] = best;
+                    parent[v] = from;
+                }
+            });
+            begin = end;
+        }
+    }
+} // namespace ariel
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Algorithms.hpp"
+#include <cstddef>
+#include <vector>
+
+#ifndef CPP_EX4_TOPOLOGICAL_HPP
+#define CPP_EX4_TOPOLOGICAL_HPP
+
+namespace ariel {
+    /**
+     * @brief Kahn's topological sort and path relaxation over its levels.
+     *
+     * Each Kahn round releases the vertices whose last predecessor left in the round
+     * before, so a round is a level: no edge joins two vertices of the same level. Rounds
+     * decrement in-degrees in parallel, and each level is sorted, so the order does not
+     * depend on the worker count.
+     *
+     * Paths are relaxed level by level. Every vertex of a level pulls its distance from its
+     * in-edges, which only reach earlier levels, so the vertices of a level are independent.
+     * The whole pass is O(V + E), and negative weights need no special care.
+     */
+    class TopologicalSort {
+    public:
+        // Source argument for paths(): every vertex starts a path of length 0
+        static constexpr std::size_t ALL_SOURCES = static_cast<std::size_t>(-1);
+
+        /**
+         * @brief Order the vertices, or find a cycle that prevents it.
+         *
+         * @param out The out-edges.
+         * @return The order and levels, or a cycle.
+         */
+        static TopologicalOrder run(const SparseIndex& out);
+
+        /**
+         * @brief Compute shortest or longest path distances over a topological order.
+         *
+         * @param in The in-edges, sorted by source within each vertex (ties pick the
+         *        smallest predecessor).
+         * @param order An order of the same graph, as returned by run().
+         * @param source The source vertex, or ALL_SOURCES.
+         * @param longest Whether to maximise instead of minimise.
+         * @param distance Receives the distances (ShortestPathTree::UNREACHABLE if not reached).
+         * @param parent Receives the predecessors (-1 if not reached; a start is its own parent).
+         */
+        static void paths(const SparseIndex& in, const TopologicalOrder& order, std::size_t source, bool longest,
+                          std::vector<long long>& distance, std::vector<int>& parent);
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_TOPOLOGICAL_HPP
@@ -0,0 +1,66 @@
+#include "UnionFind.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <numeric>
+#include <utility>
+
+namespace ariel {
+
+    UnionFind::UnionFind(std::size_t n) : parent(n) {
+        std::iota(parent.begin(), parent.end(), 0);
+    }
+
+    // Path halving: every visited element is pointed at its grandparent. A failed CAS only
+    // means another thread already shortened the path, so it is safe to ignore.
+    int UnionFind::find(int v) {
+        for (;;) {
+            std::atomic_ref<int> slot(parent[static_cast<std::size_t>(v)]);
+            int p = slot.load(std::memory_order_relaxed);
+            if (p == v) {
+                return v;
+            }
+            int grandparent = std::atomic_ref<int>(parent[static_cast<std::size_t>(p)]).load(std::memory_order_relaxed);
+            if (grandparent != p) {
+                slot.compare_exchange_weak(p, grandparent, std::memory_order_relaxed);
+            }
+            v = grandparent;
+        }
+    }
+
+    // Link the larger root under the smaller; retry if another thread re-rooted it first
+    bool UnionFind::unite(int u, int v) {
+        for (;;) {
+            u = find(u);
+            v = find(v);
+            if (u == v) {
+                return false;
+            }
+            if (u < v) {
+                std::swap(u, v);
+            }
+            int expected = u;
+            if (std::atomic_ref<int>(parent[static_cast<std::size_t>(u)])
+                    .compare_exchange_strong(expected, v, std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    void UnionFind::compress() {
+        parallelFor(parent.size(), 1 << 14, [this](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t v = begin; v < end; ++v) {
+                int root = find(static_cast<int>(v));
+                std::atomic_ref<int>(parent[v]).store(root, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    std::size_t UnionFind::size() const {
+        return parent.size();
+    }
+
+    int UnionFind::parentOf(int v) const {
+        return parent[static_cast<std::size_t>(v)];
+    }
+
+} // namespace ariel
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#ifndef CPP_EX4_UNIONFIND_HPP
+#define CPP_EX4_UNIONFIND_HPP
+
+namespace ariel {
+    /**
+     * @brief Disjoint-set forest that is safe to use from several threads at once.
+     *
+     * Roots are always linked from the larger index to the smaller one with a CAS, so the
+     * root of every set is its smallest element and concurrent unions can never form a
+     * cycle. find() compresses paths by halving, also with CAS.
+     */
+    class UnionFind {
+    public:
+        /**
+         * @brief Create n singleton sets {0}, ..., {n - 1}.
+         *
+         * @param n The number of elements.
+         */
+        explicit UnionFind(std::size_t n);
+
+        /**
+         * @brief Find the representative (smallest element) of the set containing v.
+         *
+         * @param v The element.
+         * @return The representative.
+         */
+        int find(int v);
+
+        /**
+         * @brief Merge the sets containing u and v.
+         *
+         * @param u The first element.
+         * @param v The second element.
+         * @return True if the sets were different and have been merged.
+         */
+        bool unite(int u, int v);
+
+        /**
+         * @brief Point every element directly at its representative.
+         *
+         * Must not run concurrently with unite().
+         */
+        void compress();
+
+        /**
+         * @brief Get the number of elements.
+         *
+         * @return The number of elements.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Get the parent of v without any path compression.
+         *
+         * After compress() this is the representative.
+         *
+         * @param v The element.
+         * @return The parent of v.
+         */
+        int parentOf(int v) const;
+
+    private:
+        std::vector<int> parent;
+    };
+} // namespace ariel
+
+#endif //CPP_EX4_UNIONFIND_HPP